@@ -0,0 +1,308 @@
+/* Copyright 2009, Mikael Patel
+   This file is part of vfm, virtual forth machine project.
+ 
+   vfm is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+ 
+   vfm is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+ 
+   You should have received a copy of the GNU General Public License
+   along with vfm.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include "vfm.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// NB: A sample is a batch of runs; the batch size is calibrated during
+// NB: warm-up so that a sample takes at least VFM_BENCH_SAMPLE_NS. The
+// NB: environment reset time is measured separately and subtracted.
+// NB: Dispatches are counted in a separate (instrumented) profiling run.
+
+#define VFM_BENCH_SAMPLE_NS 1000000.0
+#define VFM_BENCH_BATCH_MAX (1 << 24)
+#define VFM_BENCH_WARMUP_NS 500000000.0
+
+static double now()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static double sample(vfm_env_t* env, vfm_env_t* init, int batch, int run)
+{
+  double start = now();
+  int i;
+
+  for (i = 0; i < batch; i++) {
+    *env = *init;
+    if (run) 
+      vfm_run(env);
+    else
+      asm volatile("" : : "r" (env) : "memory");
+  }
+  return (now() - start);
+}
+
+// NB: Counters are opened one by one (not as a group) so that the
+// NB: available counters are used when the host lacks some. There is no
+// NB: generic indirect branch event; branch misses include dispatch.
+
+static struct {
+  char* name;
+  int type;
+  int config;
+} perf_event[VFM_PERF_MAX] = {
+  { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  { "branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+  { "l1i_misses", PERF_TYPE_HW_CACHE, 
+    PERF_COUNT_HW_CACHE_L1I 
+    | (PERF_COUNT_HW_CACHE_OP_READ << 8) 
+    | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+  { "l1d_misses", PERF_TYPE_HW_CACHE, 
+    PERF_COUNT_HW_CACHE_L1D 
+    | (PERF_COUNT_HW_CACHE_OP_READ << 8) 
+    | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) }
+};
+
+int vfm_perf_open(vfm_perf_t* perf)
+{
+  if (!perf) return (vfm_errno = VFM_ERR);
+
+  struct perf_event_attr attr;
+  int count = 0;
+  int i;
+
+  // Open counters for this process, user space only
+  for (i = 0; i < VFM_PERF_MAX; i++) {
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = perf_event[i].type;
+    attr.config = perf_event[i].config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perf->fd[i] = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    perf->value[i] = -1;
+    if (perf->fd[i] >= 0) count += 1;
+  }
+
+  vfm_errno = VFM_NOERR;
+  return (count);
+}
+
+int vfm_perf_start(vfm_perf_t* perf)
+{
+  if (!perf) return (vfm_errno = VFM_ERR);
+
+  int i;
+
+  for (i = 0; i < VFM_PERF_MAX; i++)
+    if (perf->fd[i] >= 0) {
+      ioctl(perf->fd[i], PERF_EVENT_IOC_RESET, 0);
+      ioctl(perf->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+int vfm_perf_stop(vfm_perf_t* perf)
+{
+  if (!perf) return (vfm_errno = VFM_ERR);
+
+  int i;
+
+  for (i = 0; i < VFM_PERF_MAX; i++) {
+    perf->value[i] = -1;
+    if (perf->fd[i] >= 0) {
+      ioctl(perf->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+      if (read(perf->fd[i], &perf->value[i], sizeof(long long)) 
+	  != sizeof(long long))
+	perf->value[i] = -1;
+    }
+  }
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+int vfm_perf_close(vfm_perf_t* perf)
+{
+  if (!perf) return (vfm_errno = VFM_ERR);
+
+  int i;
+
+  for (i = 0; i < VFM_PERF_MAX; i++)
+    if (perf->fd[i] >= 0) {
+      close(perf->fd[i]);
+      perf->fd[i] = -1;
+    }
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+int vfm_perf_print(FILE* file, vfm_perf_t* perf)
+{
+  if (!perf) return (vfm_errno = VFM_ERR);
+
+  long long* value = perf->value;
+  int i;
+
+  for (i = 0; i < VFM_PERF_MAX; i++)
+    if (value[i] >= 0)
+      fprintf(file, "%14lld %s\n", value[i], perf_event[i].name);
+  if (value[VFM_PERF_CYCLES] > 0 && value[VFM_PERF_INSTRUCTIONS] >= 0)
+    fprintf(file, "%14.2f ipc\n", 
+	    (double) value[VFM_PERF_INSTRUCTIONS] / value[VFM_PERF_CYCLES]);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+static int cmp_double(const void* x, const void* y)
+{
+  double a = *(double*) x;
+  double b = *(double*) y;
+  return ((a > b) - (a < b));
+}
+
+int vfm_bench_run(vfm_bench_t* bench, vfm_env_t* init)
+{
+  // Basic parameter check
+  if (!bench || !init || bench->samples <= 0) return (vfm_errno = VFM_ERR);
+
+  vfm_perf_t perf;
+  vfm_env_t env;
+  double* time;
+  double elapsed;
+  double reset;
+  double sum;
+  double ns;
+  int i;
+
+  // Count dispatches for a single run with profiling; the entry must
+  // halt normally as a failing run would be timed as a short one
+  memset(vfm_oprefcnt, 0, sizeof(long long) * (VFM_OPMAX + 1));
+  env = *init;
+  env.status |= VFM_PROFILING_STATUS;
+  if (vfm_run(&env)) return (vfm_errno = VFM_ERR);
+  bench->dispatches = 0;
+  for (i = 0; i <= VFM_OPMAX; i++)
+    bench->dispatches += vfm_oprefcnt[i];
+
+  // Warm-up and calibrate batch size; long runs are warmed up once
+  bench->batch = 1;
+  elapsed = 0.0;
+  for (i = 0; i == 0 || (i < bench->warmup && elapsed < VFM_BENCH_WARMUP_NS); i++) {
+    while ((ns = sample(&env, init, bench->batch, 1)) < VFM_BENCH_SAMPLE_NS
+	   && bench->batch < VFM_BENCH_BATCH_MAX)
+      bench->batch *= 2;
+    elapsed += ns;
+  }
+  reset = sample(&env, init, bench->batch, 0) / bench->batch;
+
+  // Measure samples; time and performance counters per run
+  time = (double*) malloc(sizeof(double) * bench->samples);
+  if (!time) return (vfm_errno = VFM_MALLOC_ERR);
+  vfm_perf_open(&perf);
+  vfm_perf_start(&perf);
+  for (sum = 0.0, i = 0; i < bench->samples; i++) {
+    time[i] = sample(&env, init, bench->batch, 1) / bench->batch - reset;
+    sum += time[i];
+  }
+  vfm_perf_stop(&perf);
+  vfm_perf_close(&perf);
+  for (i = 0; i < VFM_PERF_MAX; i++)
+    bench->perf[i] = (perf.value[i] < 0 ? -1.0 :
+		      (double) perf.value[i] / bench->samples / bench->batch);
+  qsort(time, bench->samples, sizeof(double), cmp_double);
+  bench->min = time[0];
+  bench->median = time[bench->samples / 2];
+  bench->p99 = time[(bench->samples * 99) / 100];
+  bench->mean = sum / bench->samples;
+  free(time);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+// NB: Results are written as JSON; one benchmark object per line so
+// NB: that a saved result can be read back as baseline
+
+int vfm_bench_store(FILE* file, vfm_bench_t* bench, int count)
+{
+  // Basic parameter check
+  if (!file) return (VFM_FILE_ERR);
+  if (!bench) return (VFM_ERR);
+
+  int i;
+  int j;
+
+  fprintf(file, "{\n  \"benchmarks\": [\n");
+  for (i = 0; i < count; i++, bench++) {
+    fprintf(file, "    { \"name\": \"%s\", \"samples\": %d, \"batch\": %d, "
+	    "\"dispatches\": %lld, \"median_ns\": %.1f, \"p99_ns\": %.1f, "
+	    "\"min_ns\": %.1f, \"mean_ns\": %.1f, \"ns_per_dispatch\": %.3f",
+	    bench->name, bench->samples, bench->batch, bench->dispatches,
+	    bench->median, bench->p99, bench->min, bench->mean,
+	    bench->dispatches ? bench->median / bench->dispatches : 0.0);
+    for (j = 0; j < VFM_PERF_MAX; j++)
+      if (bench->perf[j] >= 0.0)
+	fprintf(file, ", \"%s\": %.1f", perf_event[j].name, bench->perf[j]);
+    if (bench->perf[VFM_PERF_CYCLES] > 0.0 
+	&& bench->perf[VFM_PERF_INSTRUCTIONS] >= 0.0)
+      fprintf(file, ", \"ipc\": %.2f", 
+	      bench->perf[VFM_PERF_INSTRUCTIONS] / bench->perf[VFM_PERF_CYCLES]);
+    if (bench->baseline > 0.0)
+      fprintf(file, ", \"baseline_ns\": %.1f, \"change\": %.1f, "
+	      "\"regression\": %s",
+	      bench->baseline, 
+	      (bench->median - bench->baseline) * 100.0 / bench->baseline,
+	      bench->regression ? "true" : "false");
+    fprintf(file, " }%s\n", i + 1 < count ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+
+  return (vfm_errno = ferror(file) ? VFM_FILE_ERR : VFM_NOERR);
+}
+
+int vfm_bench_baseline(FILE* file, vfm_bench_t* bench, int count, 
+		       double threshold)
+{
+  // Basic parameter check
+  if (!file) return (VFM_FILE_ERR);
+  if (!bench) return (VFM_ERR);
+
+  char line[1024];
+  char name[256];
+  double median;
+  char* tp;
+  int regressions = 0;
+  int i;
+
+  // Read name and median from benchmark lines and compare
+  while (fgets(line, sizeof(line), file)) {
+    if (sscanf(line, " { \"name\": \"%255[^\"]\"", name) != 1) continue;
+    tp = strstr(line, "\"median_ns\": ");
+    if (!tp || sscanf(tp, "\"median_ns\": %lf", &median) != 1) continue;
+    for (i = 0; i < count; i++)
+      if (!strcmp(bench[i].name, name)) {
+	bench[i].baseline = median;
+	bench[i].regression = 
+	  (bench[i].median > median * (1.0 + threshold / 100.0));
+	regressions += bench[i].regression;
+      }
+  }
+
+  vfm_errno = VFM_NOERR;
+  return (regressions);
+}
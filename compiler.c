@@ -16,7 +16,9 @@
 
 #include "vfm.h"
 #include <string.h>
+#include <stdlib.h>
 #include <limits.h>
+#include <endian.h>
 
 // Scanner token table
 
@@ -230,6 +232,7 @@ tokentab_t tokentab[] = {
 };
 
 static int line_nr = 0;
+static int token_nr = 0;
 
 static int scan(FILE* file, char* string, int mode, tokentab_t* tab)
 {
@@ -246,6 +249,7 @@ static int scan(FILE* file, char* string, int mode, tokentab_t* tab)
     while ((c = getc(file)) != EOF && c <= ' ')
       if (c == '\n') line_nr++;
     if (c == EOF) return (EOF);
+    token_nr = line_nr;
 
     // Scan string
     do { 
@@ -287,10 +291,76 @@ static int scan(FILE* file, char* string, int mode, tokentab_t* tab)
   };
 }
 
+// Superinstruction table generated by makefile; fused operation and
+// sequence of operations (see runtime.c)
+
+typedef struct supertab_t {
+  int op;
+  int seq[3];
+} supertab_t;
+
+static supertab_t supertab[] = {
+#include "supertab.i"
+  { 0, { 0 } }
+};
+
+// Peephole optimizer state; last two generated operations and latest
+// branch target. Fusion is only allowed for contiguous operations and
+// not over a branch target
+
+static vfm_code_t* last_op[2];
+static vfm_code_t* last_label;
+
+#define next_op(p) ((p) + vfm_opsize(*(p)) + 1)
+
+static vfm_code_t* gen_super(vfm_code_t* dp, int op)
+{
+  vfm_code_t* prev = last_op[0];
+  vfm_code_t* prev2 = last_op[1];
+  supertab_t* sp;
+
+  for (sp = supertab; sp->op; sp++) {
+    if (sp->seq[2]) {
+      // Three operation sequence; remove the second operation
+      if (prev2 && sp->seq[2] == op
+	  && *prev2 == sp->seq[0] && *prev == sp->seq[1] 
+	  && next_op(prev2) == prev && next_op(prev) == dp
+	  && last_label <= prev2) {
+	vfm_oprefcnt[sp->seq[0]] -= 1;
+	vfm_oprefcnt[sp->seq[1]] -= 1;
+	vfm_oprefcnt[sp->op] += 1;
+	*prev2 = sp->op;
+	last_op[0] = prev2;
+	last_op[1] = 0;
+	return (prev);
+      }
+    } else {
+      // Two operation sequence; operands of the first are kept
+      if (prev && sp->seq[1] == op
+	  && *prev == sp->seq[0] && next_op(prev) == dp
+	  && last_label <= prev) {
+	vfm_oprefcnt[sp->seq[0]] -= 1;
+	vfm_oprefcnt[sp->op] += 1;
+	*prev = sp->op;
+	last_op[1] = 0;
+	return (dp);
+      }
+    }
+  }
+
+  // No fusion; generate operation
+  vfm_oprefcnt[op] += 1;
+  last_op[1] = prev;
+  last_op[0] = dp;
+  *dp++ = op;
+  return (dp);
+}
+
 #define USE_MAX 64
 #define STATE_MAX 64
 #define RESOLVE_MAX 64
-#define SYMBOLS_MAX 256
+#define SYMBOLS_MAX 256 // initial; grown on demand
+#define LINES_MAX 4096 // initial; grown on demand
 #define CODE_MAX 32 * 1024
 
 #define latest (&symbols[nr_symb - 1])
@@ -317,7 +387,9 @@ static int scan(FILE* file, char* string, int mode, tokentab_t* tab)
 
 #define mark(p) *++rp = p
 
-#define mark_backward() *++rp = dp
+#define mark_backward() \
+  *++rp = dp; \
+  last_label = dp
 
 #define mark_forward() \
   *++rp = dp; \
@@ -330,13 +402,32 @@ static int scan(FILE* file, char* string, int mode, tokentab_t* tab)
 
 #define resolve_forward() \
   gen = (dp - *rp - 1); \
-  *(*rp--) = gen
+  *(*rp--) = gen; \
+  last_label = dp
 
 #define resolve_backward() \
   gen = (*rp - dp - 1); \
   rp -= 1; \
   *dp++ = gen
 
+// NB: Source line table grown by doubling
+
+#define gen_line() \
+  if (nr_line == 0 || lines[nr_line - 1].line != token_nr) { \
+    if (nr_line > 0 && lines[nr_line - 1].offset == dp - code) \
+      nr_line -= 1; \
+    if (nr_line == mod->ltab.size) { \
+      line = (vfm_line_t*) realloc(lines, 2 * nr_line * sizeof(vfm_line_t)); \
+      if (!line) return (vfm_errno = VFM_MALLOC_ERR); \
+      lines = line; \
+      mod->ltab.lines = lines; \
+      mod->ltab.size = 2 * nr_line; \
+    } \
+    lines[nr_line].offset = dp - code; \
+    lines[nr_line].line = token_nr; \
+    nr_line += 1; \
+  }
+
 #define gen_char(c) *dp++ = c
 
 #define gen_allot(n) for (i = 0; i < n; i++) gen_char(0);
@@ -347,11 +438,19 @@ static int scan(FILE* file, char* string, int mode, tokentab_t* tab)
   *dp++ = (vfm_code_t) (n >> 8); \
   *dp++ = (vfm_code_t) n
 
+// NB: The low byte of the symbol index is inline before the code
+// NB: (utility.c::vfm_addr2symb); symbol table grown by doubling
+
 #define gen_symbol(s) \
-  if (nr_symb > 255) { \
-    error("module symbol limit exceeded"); \
+  if (nr_symb == mod->dict.size) { \
+    table = (vfm_symb_t*) realloc(symbols, 2 * nr_symb * sizeof(vfm_symb_t)); \
+    if (!table) return (vfm_errno = VFM_MALLOC_ERR); \
+    symbols = table; \
+    mod->dict.symbols = symbols; \
+    mod->dict.size = 2 * nr_symb; \
   } \
   *dp++ = nr_symb; \
+  last_label = dp; \
   symbols[nr_symb].name = strdup(s); \
   symbols[nr_symb].code = dp; \
   symbols[nr_symb].mode = 0; \
@@ -364,15 +463,13 @@ static int scan(FILE* file, char* string, int mode, tokentab_t* tab)
   if (gen > 127) { \
     error("extended operations is not yet implemented"); \
   } \
-  *dp++ = gen ; \
-  vfm_oprefcnt[gen] += 1;
+  dp = gen_super(dp, gen);
 
 #define gen_code(op) \
   if (is_state(SELECT_TOKEN)) { \
     error("primitive operation in select block is not allowed"); \
   } \
-  gen = *dp++ = VFM_OP_ ## op; \
-  vfm_oprefcnt[gen] += 1;
+  dp = gen_super(dp, VFM_OP_ ## op);
 
 #define gen_clit(n) \
   gen_code(CLIT); \
@@ -439,7 +536,7 @@ static int scan(FILE* file, char* string, int mode, tokentab_t* tab)
     return (vfm_errno = VFM_COMPILE_ERR); \
   }
 
-int vfm_compile(FILE* file, char* filename, char* entry, vfm_mod_t* mod)
+static int compile(FILE* file, char* filename, char* entry, vfm_mod_t* mod)
 {
   FILE* usef;
   char string[1024];
@@ -455,12 +552,17 @@ int vfm_compile(FILE* file, char* filename, char* entry, vfm_mod_t* mod)
 
   static vfm_mod_t use_mod[USE_MAX];
   static vfm_mod_t* use_ref[USE_MAX];
-  static vfm_symb_t symbols[SYMBOLS_MAX];
+  vfm_symb_t* symbols;
+  vfm_line_t* lines;
+  static char* source = 0;
 
   int used[USE_MAX];
   int nr_use = 0;
   vfm_symb_t* symb;
+  vfm_symb_t* table;
+  vfm_line_t* line;
   int nr_symb = 0;
+  int nr_line = 0;
   vfm_code_t code[CODE_MAX];
   vfm_code_t* dp = code; 
   vfm_code_t* resolve[RESOLVE_MAX];
@@ -475,21 +577,47 @@ int vfm_compile(FILE* file, char* filename, char* entry, vfm_mod_t* mod)
   // Initiate code generator structure
   for (i = 0; i < USE_MAX; i++)
     used[i] = 0;
-  for (i = 0; i < VFM_OP_HALT + 1; i++)
+  for (i = 0; i < VFM_OP_LAST + 1; i++)
     vfm_oprefcnt[i] = 0;
   mod->ident = "";
   mod->version = "";
   mod->use.mod = use_ref;
   mod->use.count = 0;
   mod->use.size = USE_MAX;
+  symbols = (vfm_symb_t*) malloc(sizeof(vfm_symb_t) * SYMBOLS_MAX);
+  if (!symbols) return (vfm_errno = VFM_MALLOC_ERR);
   mod->dict.symbols = symbols; 
-  mod->dict.size = sizeof(symbols) / sizeof(vfm_symb_t); 
+  mod->dict.size = SYMBOLS_MAX; 
   mod->dict.count = 0;
+  mod->dict.indexed = 0;
+  mod->dict.buckets = 0;
+  mod->dict.bucket = 0;
+  mod->dict.chain = 0;
+  mod->dict.pending = 0;
   mod->segment.code = code;
   mod->segment.entry = 0;
   mod->segment.count = 0;
   mod->segment.size = CODE_MAX;
+  mod->segment.refcnt = 0;
+  free(source);
+  source = strdup(filename);
+  mod->ltab.file = source;
+  lines = (vfm_line_t*) malloc(sizeof(vfm_line_t) * LINES_MAX);
+  if (!lines) return (vfm_errno = VFM_MALLOC_ERR);
+  mod->ltab.lines = lines;
+  mod->ltab.size = LINES_MAX;
+  mod->ltab.count = 0;
+  mod->image.base = 0;
+  mod->image.size = 0;
+  mod->image.offset = 0;
+  mod->image.mapped = 0;
+  mod->arena.base = 0;
+  mod->arena.size = 0;
+  mod->arena.count = 0;
+  mod->refs = 0;
   tmp[0] = 0;
+  last_op[0] = last_op[1] = 0;
+  last_label = code;
 
   // Initiate run-time tables for operation coding
   vfm_init();
@@ -567,6 +695,9 @@ int vfm_compile(FILE* file, char* filename, char* entry, vfm_mod_t* mod)
   mode = 0;
   param = 0;
   do {
+    if (mode) {
+      gen_line();
+    }
     switch (token) {
     case IDENT_TOKEN:
       if (mode) {
@@ -836,8 +967,9 @@ int vfm_compile(FILE* file, char* filename, char* entry, vfm_mod_t* mod)
     }
   }
 
-  // Set segment size and entry
+  // Set segment size, source line table and entry
   mod->segment.count = mod->segment.size = dp - code; 
+  mod->ltab.count = nr_line;
   symb = vfm_name2symb(entry, &mod->dict);
   if (symb != 0) {
     mod->segment.entry = symb->code;
@@ -849,46 +981,140 @@ int vfm_compile(FILE* file, char* filename, char* entry, vfm_mod_t* mod)
   return (VFM_NOERR);
 }
 
+// NB: The symbol table, name index and line table of the compiled
+// NB: module are used by the caller (profile, store) and released with
+// NB: the next compile, or when the compile fails.
+
+static vfm_dict_t compiled_dict;
+static vfm_ltab_t compiled_ltab;
+
+static void release()
+{
+  free(compiled_dict.symbols);
+  free(compiled_dict.bucket);
+  free(compiled_dict.chain);
+  free(compiled_ltab.lines);
+  memset(&compiled_dict, 0, sizeof(compiled_dict));
+  memset(&compiled_ltab, 0, sizeof(compiled_ltab));
+}
+
+int vfm_compile(FILE* file, char* filename, char* entry, vfm_mod_t* mod)
+{
+  int res;
+
+  // Release tables of the previous module and compile
+  release();
+  memset(&mod->dict, 0, sizeof(mod->dict));
+  memset(&mod->ltab, 0, sizeof(mod->ltab));
+  res = compile(file, filename, entry, mod);
+  compiled_dict = mod->dict;
+  compiled_ltab = mod->ltab;
+  if (res) {
+    release();
+    memset(&mod->dict, 0, sizeof(mod->dict));
+    memset(&mod->ltab, 0, sizeof(mod->ltab));
+  }
+  return (res);
+}
+
+// NB: Object file layout; see vfm_obj_t. Sections are padded to
+// NB: alignment so that tables may be accessed in a mapped file
+
+static unsigned align(unsigned offset)
+{
+  return ((offset + VFM_OBJ_ALIGN - 1) & ~(VFM_OBJ_ALIGN - 1));
+}
+
+static void fputpad(unsigned offset, FILE* file)
+{
+  for (; offset != align(offset); offset++) fputc(0, file);
+}
+
+static unsigned fputoff(char* str, unsigned offset, FILE* file)
+{
+  fputint(offset, file);
+  return (offset + strlen(str) + 1);
+}
+
 int vfm_store(FILE* file, vfm_mod_t *mod)
 {
-  vfm_symb_t* symb;
-  int entry;
+  vfm_symb_t* symb = mod->dict.symbols;
+  char* source = (mod->ltab.count ? mod->ltab.file : "");
+  unsigned strings;
+  vfm_obj_t obj;
+  unsigned* fp;
+  unsigned str;
   int i;
 
-  // Calculate entry
-  if (mod->segment.entry)
-    entry = mod->segment.entry - mod->segment.code;
-  else
-    entry = 0;
+  // Calculate layout; header, use, symbol and line tables, strings, code
+  memset(&obj, 0, sizeof(obj));
+  strcpy(obj.magic, VFM_OBJ_MAGIC);
+  obj.timestamp = mod->timestamp;
+  obj.entry = (mod->segment.entry ? mod->segment.entry - mod->segment.code : 0);
+  obj.uses = mod->use.count;
+  obj.use = align(sizeof(obj));
+  obj.symbols = mod->dict.count;
+  obj.symbol = align(obj.use + obj.uses * 2 * sizeof(unsigned));
+  obj.lines = mod->ltab.count;
+  obj.line = align(obj.symbol + obj.symbols * 3 * sizeof(unsigned));
+  obj.strings = align(obj.line + obj.lines * 2 * sizeof(unsigned));
+  strings = strlen(mod->name) + strlen(mod->ident) + strlen(mod->version) 
+    + strlen(source) + 4;
+  for (i = 0; i < mod->use.count; i++)
+    strings += strlen(mod->use.mod[i]->name) + 1;
+  for (i = 0; i < mod->dict.count; i++)
+    strings += strlen(symb[i].name) + 1;
+  obj.codesize = mod->segment.size;
+  obj.code = align(obj.strings + strings);
+  obj.size = obj.code + obj.codesize;
+  obj.name = 0;
+  obj.ident = obj.name + strlen(mod->name) + 1;
+  obj.version = obj.ident + strlen(mod->ident) + 1;
+  obj.file = obj.version + strlen(mod->version) + 1;
+  str = obj.file + strlen(source) + 1;
+
+  // Write header; fields following magic string
+  for (fp = &obj.size; fp <= &obj.strings; fp++) *fp = htobe32(*fp);
+  fwrite(&obj, sizeof(obj), 1, file);
+  fputpad(sizeof(obj), file);
+  for (fp = &obj.size; fp <= &obj.strings; fp++) *fp = be32toh(*fp);
+
+  // Write use table; name and compile time
+  for (i = 0; i < mod->use.count; i++) {
+    str = fputoff(mod->use.mod[i]->name, str, file);
+    fputint((int) mod->use.mod[i]->timestamp, file);
+  }
+  fputpad(obj.use + obj.uses * 2 * sizeof(unsigned), file);
+
+  // Write symbol table; name, code offset and mode
+  for (i = 0; i < mod->dict.count; i++) {
+    str = fputoff(symb[i].name, str, file);
+    fputint(symb[i].code - mod->segment.code, file);
+    fputint(symb[i].mode, file);
+  }
+  fputpad(obj.symbol + obj.symbols * 3 * sizeof(unsigned), file);
 
-  // Write magic header
-  fputs(VFM_OBJ_MAGIC, file);
+  // Write source line table (debug); offset and line
+  for (i = 0; i < mod->ltab.count; i++) {
+    fputint(mod->ltab.lines[i].offset, file);
+    fputint(mod->ltab.lines[i].line, file);
+  }
+  fputpad(obj.line + obj.lines * 2 * sizeof(unsigned), file);
 
-  // Write module name, package, version, compile time and use module list
+  // Write string table in the order of the offsets above
   fputstr(mod->name, file);
   fputstr(mod->ident, file);
   fputstr(mod->version, file);
-  fputint((int) mod->timestamp, file);
-  fputint(mod->use.count, file);
-  for(i = 0; i < mod->use.count; i++) {
+  fputstr(source, file);
+  for (i = 0; i < mod->use.count; i++)
     fputstr(mod->use.mod[i]->name, file);
-    fputint((int) mod->use.mod[i]->timestamp, file);
-  }
+  for (i = 0; i < mod->dict.count; i++)
+    fputstr(symb[i].name, file);
+  fputpad(obj.strings + strings, file);
 
-  // Write code area; relocated entry, size and code area
-  fputint(entry, file);
-  fputint(mod->segment.size, file);
+  // Write code area
   fwrite(mod->segment.code, 1, mod->segment.size, file);
-
-  // Write symbol table; count *[name, code, mode]
-  fputint(mod->dict.count, file);
-  symb = mod->dict.symbols;
-  for(i = 0; i < mod->dict.count; i++) {
-    fputstr(symb[i].name, file);
-    fputint(symb[i].code - mod->segment.code, file);
-    fputint(symb[i].mode, file);
-  }
-  return (VFM_NOERR);
+  return (ferror(file) ? VFM_FILE_ERR : VFM_NOERR);
 }
 
 #define CODE_PER_LINE 8
@@ -937,7 +1163,7 @@ int vfm_gencode(FILE* file, vfm_mod_t *mod)
   // Generate symbols 
   fprintf(file, "vfm_symb_t %s_symbols[] = {\n", name);
   for(i = 0; i < count; i++) {
-    fprintf(file, "  { \"%s\", %s_code + %d, %d, %d },\n", 
+    fprintf(file, "  { \"%s\", %s_code + %d, %d, %lld },\n", 
 	    symbols[i].name, 
 	    name, symbols[i].code - code,
 	    symbols[i].mode,
@@ -1,18 +1,12 @@
 #include <stdio.h>
 #include <time.h>
 
-// Pointer to next (normal, trace and/or tracing)
-
-#define VFM_USE_NEXT_POINTER
-
-// Inline the next (when pointer to next is undefined only)
-
-#define VFM_USE_INLINE_NEXT
-
 // Magic strings for object and library files
 
-#define VFM_OBJ_MAGIC "!vfm:token:obj:0.1\n"
-#define VFM_LIB_MAGIC "!vfm:token:lib:0.1\n"
+#define VFM_OBJ_MAGIC "!vfm:token:obj:0.4\n"
+#define VFM_LIB_MAGIC "!vfm:token:lib:0.2\n"
+#define VFM_PROF_MAGIC "!vfm:token:prof:0.2\n"
+#define VFM_IMG_MAGIC "!vfm:token:img:0.2\n"
 
 // Data and code definition
 
@@ -35,13 +29,26 @@ typedef struct vfm_symb_t {
   char* name;
   vfm_code_t* code;
   int mode;
-  int refcnt;
+  long long refcnt;
 } vfm_symb_t;
 
+typedef struct vfm_mod_t vfm_mod_t;
+
+// NB: Symbol name index (hash) is built on lookup and when loading;
+// NB: bucket is the latest symbol index and chain the previous symbol
+// NB: in the same bucket. Index fields are zero in generated code.
+// NB: Pending is the module when the symbol table is not loaded; it is
+// NB: loaded on first lookup (vfm_load_symbols).
+
 typedef struct vfm_dict_t {
   int count;
   int size;
   vfm_symb_t* symbols;
+  int indexed;
+  int buckets;
+  int* bucket;
+  int* chain;
+  vfm_mod_t* pending;
 } vfm_dict_t;
 
 typedef struct vfm_segm_t {
@@ -49,9 +56,47 @@ typedef struct vfm_segm_t {
   int size;
   vfm_code_t* code;
   vfm_code_t* entry;
+  long long* refcnt;
 } vfm_segm_t;
 
-typedef struct vfm_mod_t vfm_mod_t;
+// Source line table (debug); code offset and line number in source file
+
+typedef struct vfm_line_t {
+  int offset;
+  int line;
+} vfm_line_t;
+
+typedef struct vfm_ltab_t {
+  int count;
+  int size;
+  char* file;
+  vfm_line_t* lines;
+} vfm_ltab_t;
+
+// Object image; memory mapped object file, read buffer or member of a
+// mapped archive (loader.c). Mapping is from page boundary; object at
+// offset in mapping. Archive mappings are kept when unloaded
+
+#define VFM_IMAGE_READ 0
+#define VFM_IMAGE_MAPPED 1
+#define VFM_IMAGE_ARCHIVE 2
+
+typedef struct vfm_image_t {
+  char* base;
+  int size;
+  int offset;
+  int mapped;
+} vfm_image_t;
+
+// Module arena; use list, symbol and line tables and name index
+// of a loaded module in a block (loader.c). Blocks are chained when
+// symbols are loaded on demand. Freed on unload
+
+typedef struct vfm_arena_t {
+  char* base;
+  int size;
+  int count;
+} vfm_arena_t;
 
 typedef struct vfm_use_t {
   int count;
@@ -67,8 +112,103 @@ struct vfm_mod_t {
   vfm_use_t use;
   vfm_dict_t dict;
   vfm_segm_t segment;
+  vfm_ltab_t ltab;
+  vfm_image_t image;
+  vfm_arena_t arena;
+  int refs;
 };
 
+// NB: Used modules are stubs with lazy loading (vfm_lazy); name and
+// NB: timestamp only. The code segment is set last when loaded
+
+#define VFM_LOADED(mod) (__atomic_load_n(&(mod)->segment.code, __ATOMIC_ACQUIRE) != 0)
+#define VFM_PENDING(dict) (__atomic_load_n(&(dict)->pending, __ATOMIC_ACQUIRE) != 0)
+
+// NB: Object file format; fixed size header followed by use, symbol
+// NB: and line tables, string table and code. Fields are big-endian
+// NB: 32-bit. Tables and sections are offsets from the header and 
+// NB: aligned (VFM_OBJ_ALIGN). Names are offsets in the string table.
+// NB: Use entries are [name, timestamp], symbol entries [name, offset,
+// NB: mode] and line entries [offset, line].
+
+#define VFM_OBJ_ALIGN 8
+
+typedef struct vfm_obj_t {
+  char magic[24];
+  unsigned size;
+  unsigned timestamp;
+  unsigned name;
+  unsigned ident;
+  unsigned version;
+  unsigned file;
+  unsigned entry;
+  unsigned uses;
+  unsigned use;
+  unsigned symbols;
+  unsigned symbol;
+  unsigned lines;
+  unsigned line;
+  unsigned codesize;
+  unsigned code;
+  unsigned strings;
+} vfm_obj_t;
+
+// NB: Linked image format (image.c); header followed by module structures,
+// NB: tables, code and data heap as in memory with pointers as offsets
+// NB: from the image start, and a table of the offsets of the pointers
+// NB: (relocation). Native byte order and word size (checked).
+
+typedef struct vfm_img_t {
+  char magic[24];
+  unsigned word;
+  unsigned size;
+  unsigned root;
+  unsigned entry;
+  unsigned heap;
+  unsigned heapsize;
+  unsigned relocs;
+  unsigned reloc;
+} vfm_img_t;
+
+// NB: Archive file format; fixed size header followed by member, bucket
+// NB: and string tables, and the object files. Fields are big-endian
+// NB: 32-bit. The name index is a hash table (vfm_strhash) with a power
+// NB: of two buckets; bucket and next are member number plus one (zero
+// NB: ends the chain). Names are offsets in the string table. Object
+// NB: files are at page aligned file positions (VFM_ARC_ALIGN) so that
+// NB: each is mapped without the neighbouring members and clean code
+// NB: pages are shared between processes (page cache). The alignment is
+// NB: the largest host page size (64 KiB) so that an archive is page
+// NB: aligned on any host; the loader maps at the host page size. Code
+// NB: is mapped private and writable (copy on write) as variables are
+// NB: in the code segment; only pages without written variables are
+// NB: shared. Read-only shared code requires a separate data segment
+// NB: in the object format.
+
+#define VFM_ARC_ALIGN 65536
+
+typedef struct vfm_lib_t {
+  char magic[24];
+  unsigned count;
+  unsigned buckets;
+  unsigned member;
+  unsigned bucket;
+  unsigned strings;
+  unsigned size;
+} vfm_lib_t;
+
+typedef struct vfm_member_t {
+  unsigned name;
+  unsigned ident;
+  unsigned version;
+  unsigned timestamp;
+  unsigned size;
+  unsigned pos;
+  unsigned next;
+} vfm_member_t;
+
+// Archive member (vfm_arc_member); names point into the archive
+
 typedef struct vfm_map_t {
   char* name;
   char* ident;
@@ -78,17 +218,34 @@ typedef struct vfm_map_t {
   int pos;
 } vfm_map_t;
 
+// Archive; memory mapped archive file with members loaded in place, or
+// the header and tables read from streams that cannot be mapped (fmemopen)
+// with members read from the file. An archive in (writable) memory, e.g.
+// embedded, is used in place as a mapping
+
+#define VFM_ARC_READ 0
+#define VFM_ARC_MAPPED 1
+#define VFM_ARC_MEMORY 2
+
 typedef struct vfm_arc_t {
+  char* base;
+  long size;
+  int mapped;
   int count;
-  int size;
-  int pos;
-  vfm_map_t* map;
+  int buckets;
 } vfm_arc_t;
 
 #define VFM_NORMAL_STATUS 0
 #define VFM_TRACING_STATUS 1
 #define VFM_PROFILING_STATUS 2
 #define VFM_IO_WAIT_STATUS 4
+#define VFM_NGRAM_STATUS 8
+#define VFM_RESUME_STATUS 16
+#define VFM_INSTRUMENTED_STATUS (VFM_TRACING_STATUS | VFM_PROFILING_STATUS)
+
+// NB: Returned by the engines (runtime.c) when status requires the other
+
+#define VFM_SWITCH 1
 
 // TODO: Add double linked queue for threading
 
@@ -102,16 +259,48 @@ typedef struct vfm_env_t {
   vfm_data_t*  sp0;
   vfm_code_t** rp0;
   vfm_data_t*  dp0;
+  int spsize;
+  int rpsize;
+  int dpsize;
 } vfm_env_t;
 
+// NB: Stacks are poisoned before run; high-water marks are found by
+// NB: scanning for the first non-poisoned byte from the top. The heap
+// NB: is not poisoned (zero filled); usage is dp - dp0 (vfm_high_water,
+// NB: error when the stacks were not poisoned)
+
+#define VFM_POISON 0xa5
+
+// Memory usage of loaded module (bytes)
+
+typedef struct vfm_mem_t {
+  int module;
+  int code;
+  int symbols;
+  int lines;
+  int counters;
+} vfm_mem_t;
+
 // NB: Number of byte codes (128 single byte, and three pages double byte)
 
 #define VFM_OPMAX 0x3ff
 
-extern int vfm_errno;
+extern __thread int vfm_errno;
 extern void* vfm_optab;
 extern char** vfm_opname;
-extern int vfm_oprefcnt[];
+extern long long vfm_oprefcnt[];
+extern volatile int vfm_request;
+extern volatile int vfm_tasks;
+extern char* vfm_metrics_file;
+extern int vfm_lazy;
+
+// External requests to running environments; polled on run and function call.
+// The safepoint request is not cleared by the environments; each parks
+// until the request is withdrawn (vfm_park, vfm_reload, vfm_reclaim)
+
+#define VFM_SNAPSHOT_REQUEST 1
+#define VFM_PROFILE_REQUEST 2
+#define VFM_SAFEPOINT_REQUEST 4
 
 // TODO: Add vfm_perror for simple print of error message
 // TODO: Complete list of error codes
@@ -126,26 +315,75 @@ extern int vfm_oprefcnt[];
 #define VFM_MODULE_TIMESTAMP_ERR -7
 #define VFM_COMPILE_ERR -8
 #define VFM_ARC_SEARCH_ERR -9
+#define VFM_TRAP_ERR -10
+#define VFM_MODULE_USED_ERR -11
+#define VFM_MODULE_LAYOUT_ERR -12
+
+// Hardware performance counters (perf_event_open); counters that are
+// not available on the host have the value -1
+
+#define VFM_PERF_CYCLES 0
+#define VFM_PERF_INSTRUCTIONS 1
+#define VFM_PERF_BRANCH_MISSES 2
+#define VFM_PERF_L1I_MISSES 3
+#define VFM_PERF_L1D_MISSES 4
+#define VFM_PERF_MAX 5
+
+typedef struct vfm_perf_t {
+  int fd[VFM_PERF_MAX];
+  long long value[VFM_PERF_MAX];
+} vfm_perf_t;
+
+// Benchmark measurement; time per run in nano-seconds (file: bench.c)
+
+typedef struct vfm_bench_t {
+  char* name;
+  int warmup;
+  int samples;
+  int batch;
+  long long dispatches;
+  double median;
+  double p99;
+  double min;
+  double mean;
+  double baseline;
+  int regression;
+  double perf[VFM_PERF_MAX];
+} vfm_bench_t;
 
 // Utility functions (file: utility.c)
 
 int fgetint(int* x, FILE* file);
 int fputint(int n, FILE* file);
+int fgetlong(long long* x, FILE* file);
+int fputlong(long long n, FILE* file);
 int fgetstr(char* buf, FILE* file);
 int fputstr(char* str, FILE* file);
 
+int vfm_opsize(int op);
+
 char* vfm_parse_entry(char* name);
 char* vfm_parse_module(char* name);
 
 char* vfm_fullname(vfm_mod_t* mod);
 char* vfm_name2path(char* name);
+unsigned vfm_strhash(char* s);
 
 vfm_symb_t* vfm_name2symb(char* name, vfm_dict_t *dict);
+int vfm_dict_index(vfm_dict_t *dict);
 vfm_symb_t* vfm_addr2symb(vfm_code_t* addr, vfm_dict_t *dict);
+vfm_line_t* vfm_addr2line(vfm_code_t* addr, vfm_mod_t *mod);
 
 int vfm_name2dict(char* name, vfm_dict_t **dict, vfm_mod_t *mod);
 
 int vfm_dump_module(FILE* file, int recursive, vfm_mod_t *mod);
+int vfm_memory(vfm_mem_t* mem, vfm_mod_t *mod);
+int vfm_disasm(FILE* file, char* entry, vfm_mod_t *mod);
+int vfm_opusage(int* count, vfm_mod_t *mod);
+int vfm_dump_memory(FILE* file, int header, vfm_mod_t *mod);
+int vfm_poison(vfm_env_t* env);
+int vfm_high_water(vfm_env_t* env, int* data, int* ret, int* heap);
+int vfm_dump_env(FILE* file, vfm_env_t* env);
 int vfm_lookup_module(char* fullname, vfm_symb_t** symb, vfm_mod_t *mod);
 
 FILE* vfm_fopen_obj_file(char* object);
@@ -160,16 +398,53 @@ int vfm_gencode(FILE* file, vfm_mod_t *mod);
 // Loader functions (file: loader.c)
 
 int vfm_load(FILE* file, int debug, vfm_mod_t *mod);
+int vfm_unload(vfm_mod_t *mod);
+int vfm_resolve(vfm_mod_t *mod);
+int vfm_load_symbols(vfm_mod_t *mod);
+int vfm_reload(vfm_mod_t *mod, FILE* file);
+int vfm_reclaim(vfm_env_t** env, int count);
+int vfm_park(vfm_env_t* env);
 int vfm_arc_map_load(FILE* file, vfm_arc_t* arc);
+int vfm_arc_init(vfm_arc_t* arc, char* base, long size);
 int vfm_arc_load(FILE* file, char* name, int debug, vfm_mod_t *mod, vfm_arc_t* arc);
+int vfm_arc_close(vfm_arc_t* arc);
+int vfm_arc_member(vfm_arc_t* arc, int nr, vfm_map_t* map);
+
+// Image functions (file: image.c)
+
+int vfm_save_image(FILE* file, vfm_mod_t *mod, vfm_code_t* entry, vfm_data_t* heap, int size);
+int vfm_load_image(FILE* file, vfm_mod_t **mod, vfm_code_t** entry, vfm_data_t** heap, int* size);
 
 // Runtime functions (file: runtime.c)
 
 int vfm_init();
 int vfm_run(vfm_env_t* env);
+int vfm_run_fast(vfm_env_t* env);
+int vfm_run_instrumented(vfm_env_t* env);
 
 // Profiler functions (file: profiler.c)
 
 int vfm_profile(FILE* file, vfm_mod_t *mod);
 int vfm_coverage(FILE* file, vfm_mod_t *mod);
 int vfm_reset_counters(vfm_mod_t *mod);
+long long* vfm_counters(vfm_mod_t *mod);
+int vfm_line_profile(FILE* file, vfm_mod_t *mod);
+int vfm_lcov(FILE* file, vfm_mod_t *mod);
+int vfm_profile_store(FILE* file, vfm_mod_t *mod);
+int vfm_profile_load(FILE* file, vfm_mod_t *mod);
+int vfm_metrics(FILE* file, vfm_env_t *env);
+int vfm_snapshot(vfm_env_t *env);
+void vfm_ngram_count(int op);
+int vfm_ngram_profile(FILE* file, int max);
+int vfm_ngram_reset();
+
+// Benchmark functions (file: bench.c)
+
+int vfm_bench_run(vfm_bench_t* bench, vfm_env_t* init);
+int vfm_bench_store(FILE* file, vfm_bench_t* bench, int count);
+int vfm_bench_baseline(FILE* file, vfm_bench_t* bench, int count, double threshold);
+int vfm_perf_open(vfm_perf_t* perf);
+int vfm_perf_start(vfm_perf_t* perf);
+int vfm_perf_stop(vfm_perf_t* perf);
+int vfm_perf_close(vfm_perf_t* perf);
+int vfm_perf_print(FILE* file, vfm_perf_t* perf);
@@ -0,0 +1,47 @@
+# NB: Generate a synthetic module graph (dir/*.fpp) for the loader and
+# NB: compiler scaling benchmark (vfscale). Modules are a tree with the
+# NB: given depth and fan-out; level l has fanout^l modules named
+# NB: g<level>_<index> and each uses its fan-out modules on the next
+# NB: level. Each module has the given number of words, calling earlier
+# NB: words (logarithmic call depth), and a main calling the used
+# NB: modules. Compile order, leaves first, is written to dir/order.
+
+function module(l, i, j, k, file, name) {
+  name = "g" l "_" i;
+  file = dir "/" name ".fpp";
+  print "// Synthetic module generated by makefile (graph.awk)" > file;
+  print "" > file;
+  print "module " name > file;
+  print "" > file;
+  if (l < depth)
+    for (j = 0; j < fanout; j++)
+      print "  use g" (l + 1) "_" (i * fanout + j) > file;
+  print "" > file;
+  print "  : w0 ( x -- y ) 1+ ;" > file;
+  for (k = 1; k < symbols; k++)
+    print "  : w" k " ( x -- y ) w" int(k / 2) " 1+ ;" > file;
+  printf "  : main ( -- ) 0 w%d drop", symbols - 1 > file;
+  if (l < depth)
+    for (j = 0; j < fanout; j++)
+      printf " g%d_%d::main", l + 1, i * fanout + j > file;
+  print " ;" > file;
+  print "" > file;
+  print "endmodule" > file;
+  close(file);
+  print name > (dir "/order");
+}
+
+BEGIN {
+  if (depth == "") depth = 2;
+  if (fanout == "") fanout = 4;
+  if (symbols == "") symbols = 50;
+  if (dir == "") dir = "graph";
+  printf "" > (dir "/order");
+  width = fanout ^ depth;
+  for (l = depth; l >= 0; l--) {
+    for (i = 0; i < width; i++)
+      module(l, i);
+    width = width / fanout;
+  }
+  close(dir "/order");
+}
@@ -0,0 +1,323 @@
+/* Copyright 2009, Mikael Patel
+   This file is part of vfm, virtual forth machine project.
+
+   vfm is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   vfm is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with vfm.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include "vfm.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// NB: Linked image of a module graph; modules, use links, symbols,
+// NB: source lines, code (with variables) and data heap. Written as in
+// NB: memory with pointers as offsets and relocated by the base address
+// NB: when mapped (private, copy on write). Instruction counters are
+// NB: allocated when profiled and name indexes are built on lookup.
+// NB: Addresses stored in variables and the data heap are not
+// NB: relocated. Modules in an image are not registered and cannot be
+// NB: unloaded.
+
+#define IMG_ALIGN 8
+
+typedef struct buf_t {
+  char* data;
+  int count;
+  int size;
+  unsigned* reloc;
+  int relocs;
+  int rsize;
+  int err;
+} buf_t;
+
+#define MOD(buf, at) ((vfm_mod_t*) ((buf)->data + (at)))
+#define SYMB(buf, at) ((vfm_symb_t*) ((buf)->data + (at)))
+
+// NB: Append zero filled and aligned data; returns offset in image.
+// NB: Errors are flagged and offset zero (header) is returned.
+
+static int put(buf_t* buf, void* data, int size)
+{
+  int len = (size + IMG_ALIGN - 1) & ~(IMG_ALIGN - 1);
+  int res = buf->count;
+  char* dp;
+  int n;
+
+  if (buf->count + len > buf->size) {
+    for (n = (buf->size ? buf->size : 4096); buf->count + len > n; n *= 2);
+    dp = (char*) realloc(buf->data, n);
+    if (!dp) {
+      buf->err = 1;
+      return (0);
+    }
+    buf->data = dp;
+    buf->size = n;
+  }
+  memset(buf->data + res, 0, len);
+  if (data) memcpy(buf->data + res, data, size);
+  buf->count += len;
+  return (res);
+}
+
+static int str(buf_t* buf, char* s)
+{
+  return (put(buf, s, strlen(s) + 1));
+}
+
+// NB: Set pointer at offset to target offset and add relocation
+
+static void ptr(buf_t* buf, int at, int target)
+{
+  unsigned* rp;
+  int n;
+
+  if (buf->err) return;
+  *(char**) (buf->data + at) = (char*) (long) target;
+  if (buf->relocs == buf->rsize) {
+    n = (buf->rsize ? 2 * buf->rsize : 1024);
+    rp = (unsigned*) realloc(buf->reloc, sizeof(unsigned) * n);
+    if (!rp) {
+      buf->err = 1;
+      return;
+    }
+    buf->reloc = rp;
+    buf->rsize = n;
+  }
+  buf->reloc[buf->relocs++] = at;
+}
+
+static int collect(vfm_mod_t* mod, vfm_mod_t*** mods, int* nr, int* size)
+{
+  int i;
+
+  // Resolve stubs (lazy loading) and symbols so that the image is complete
+  if (!VFM_LOADED(mod) && vfm_resolve(mod)) return (vfm_errno);
+  if (VFM_PENDING(&mod->dict) && vfm_load_symbols(mod)) return (vfm_errno);
+
+  // Add module once and collect used modules
+  for (i = 0; i < *nr; i++)
+    if ((*mods)[i] == mod) return (VFM_NOERR);
+  if (*nr == *size) {
+    *size = (*size ? 2 * *size : 64);
+    *mods = (vfm_mod_t**) realloc(*mods, sizeof(vfm_mod_t*) * *size);
+    if (!*mods) return (VFM_MALLOC_ERR);
+  }
+  (*mods)[(*nr)++] = mod;
+  for (i = 0; i < mod->use.count; i++)
+    if (collect(mod->use.mod[i], mods, nr, size)) return (vfm_errno);
+  return (VFM_NOERR);
+}
+
+static void module(buf_t* buf, int at, vfm_mod_t* mod, vfm_mod_t** mods, int nr, int* off)
+{
+  vfm_symb_t* symb;
+  int code;
+  int use;
+  int sp;
+  int i;
+  int j;
+
+  // Counts and timestamp; pointers are set with relocation
+  MOD(buf, at)->timestamp = mod->timestamp;
+  MOD(buf, at)->use.count = MOD(buf, at)->use.size = mod->use.count;
+  MOD(buf, at)->dict.count = MOD(buf, at)->dict.size = mod->dict.count;
+  MOD(buf, at)->segment.count = mod->segment.count;
+  MOD(buf, at)->segment.size = mod->segment.size;
+  MOD(buf, at)->ltab.count = MOD(buf, at)->ltab.size = mod->ltab.count;
+
+  // Names
+  ptr(buf, at + offsetof(vfm_mod_t, name), str(buf, mod->name));
+  ptr(buf, at + offsetof(vfm_mod_t, ident), str(buf, mod->ident));
+  ptr(buf, at + offsetof(vfm_mod_t, version), str(buf, mod->version));
+
+  // Code segment with variables and entry
+  code = put(buf, mod->segment.code, mod->segment.size);
+  ptr(buf, at + offsetof(vfm_mod_t, segment.code), code);
+  if (mod->segment.entry)
+    ptr(buf, at + offsetof(vfm_mod_t, segment.entry),
+	code + (mod->segment.entry - mod->segment.code));
+
+  // Use links to module structures in image
+  if (mod->use.count > 0) {
+    use = put(buf, 0, sizeof(vfm_mod_t*) * (mod->use.count + 1));
+    for (i = 0; i < mod->use.count; i++) {
+      for (j = 0; j < nr && mods[j] != mod->use.mod[i]; j++);
+      ptr(buf, use + i * sizeof(vfm_mod_t*), off[j]);
+    }
+    ptr(buf, at + offsetof(vfm_mod_t, use.mod), use);
+  }
+
+  // Symbol table; names and code in image
+  if (mod->dict.count > 0) {
+    sp = put(buf, 0, sizeof(vfm_symb_t) * mod->dict.count);
+    for (i = 0; i < mod->dict.count; i++) {
+      symb = &mod->dict.symbols[i];
+      SYMB(buf, sp)[i].mode = symb->mode;
+      ptr(buf, sp + i * sizeof(vfm_symb_t) + offsetof(vfm_symb_t, name),
+	  str(buf, symb->name));
+      ptr(buf, sp + i * sizeof(vfm_symb_t) + offsetof(vfm_symb_t, code),
+	  code + (symb->code - mod->segment.code));
+    }
+    ptr(buf, at + offsetof(vfm_mod_t, dict.symbols), sp);
+  }
+
+  // Source line table
+  ptr(buf, at + offsetof(vfm_mod_t, ltab.file),
+      str(buf, mod->ltab.file ? mod->ltab.file : ""));
+  if (mod->ltab.count > 0)
+    ptr(buf, at + offsetof(vfm_mod_t, ltab.lines),
+	put(buf, mod->ltab.lines, sizeof(vfm_line_t) * mod->ltab.count));
+}
+
+int vfm_save_image(FILE* file, vfm_mod_t *mod, vfm_code_t* entry, vfm_data_t* heap, int size)
+{
+  if (!file) return (vfm_errno = VFM_FILE_ERR);
+  if (!mod) return (vfm_errno = VFM_ERR);
+
+  buf_t buf = { 0 };
+  vfm_img_t* img;
+  vfm_mod_t** mods = 0;
+  vfm_mod_t* mp;
+  int* off = 0;
+  int heapoff;
+  int nr = 0;
+  int max = 0;
+  int i;
+
+  // Collect module graph; root module first
+  if (collect(mod, &mods, &nr, &max)) {
+    free(mods);
+    return (vfm_errno);
+  }
+  off = (int*) malloc(sizeof(int) * nr);
+  if (!off) {
+    free(mods);
+    return (vfm_errno = VFM_MALLOC_ERR);
+  }
+
+  // Header, module structures, modules and data heap
+  put(&buf, 0, sizeof(vfm_img_t));
+  for (i = 0; i < nr; i++)
+    off[i] = put(&buf, 0, sizeof(vfm_mod_t));
+  for (i = 0; i < nr; i++)
+    module(&buf, off[i], mods[i], mods, nr, off);
+  heapoff = put(&buf, heap, size);
+  if (buf.err) {
+    free(buf.data);
+    free(buf.reloc);
+    free(mods);
+    free(off);
+    return (vfm_errno = VFM_MALLOC_ERR);
+  }
+
+  // Header; entry is an offset in the code of the module it is in
+  img = (vfm_img_t*) buf.data;
+  strncpy(img->magic, VFM_IMG_MAGIC, sizeof(img->magic));
+  img->word = sizeof(void*);
+  img->size = buf.count;
+  img->root = off[0];
+  img->entry = 0;
+  for (i = 0; i < nr; i++) {
+    mp = mods[i];
+    if (entry >= mp->segment.code && entry < mp->segment.code + mp->segment.size)
+      img->entry = (long) MOD(&buf, off[i])->segment.code + (entry - mp->segment.code);
+  }
+  img->heap = heapoff;
+  img->heapsize = size;
+  img->relocs = buf.relocs;
+  img->reloc = buf.count;
+
+  // Write image and relocation table
+  fwrite(buf.data, 1, buf.count, file);
+  fwrite(buf.reloc, sizeof(unsigned), buf.relocs, file);
+  free(buf.data);
+  free(buf.reloc);
+  free(mods);
+  free(off);
+
+  return (vfm_errno = (ferror(file) ? VFM_FILE_ERR : VFM_NOERR));
+}
+
+int vfm_load_image(FILE* file, vfm_mod_t **mod, vfm_code_t** entry, vfm_data_t** heap, int* size)
+{
+  if (!file) return (vfm_errno = VFM_FILE_ERR);
+  if (!mod) return (vfm_errno = VFM_ERR);
+
+  struct stat st;
+  vfm_img_t img;
+  unsigned* rp;
+  char* base;
+  int mapped;
+  long len;
+  unsigned i;
+
+  // Read header and check magic string and word size
+  if (fread(&img, sizeof(img), 1, file) != 1
+      || strncmp(img.magic, VFM_IMG_MAGIC, sizeof(img.magic))
+      || img.word != sizeof(void*))
+    return (vfm_errno = VFM_MAGIC_ERR);
+
+  // Check that the header offsets are within the image (before the
+  // relocation table) and that the table size does not overflow
+  if (img.size != img.reloc
+      || img.reloc < sizeof(img) + sizeof(vfm_mod_t)
+      || img.relocs > (~0U - img.reloc) / sizeof(unsigned)
+      || img.root < sizeof(img)
+      || img.root > img.reloc - sizeof(vfm_mod_t)
+      || img.entry >= img.reloc
+      || img.heap > img.reloc
+      || img.heapsize > img.reloc - img.heap)
+    return (vfm_errno = VFM_MAGIC_ERR);
+  len = (long) img.reloc + sizeof(unsigned) * (long) img.relocs;
+
+  // Map image; streams that cannot be mapped are read into a buffer
+  base = MAP_FAILED;
+  if (!fstat(fileno(file), &st) && S_ISREG(st.st_mode) && st.st_size >= len)
+    base = mmap(0, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno(file), 0);
+  mapped = (base != MAP_FAILED);
+  if (!mapped) {
+    base = (char*) malloc(len);
+    if (!base) return (vfm_errno = VFM_MALLOC_ERR);
+    memcpy(base, &img, sizeof(img));
+    if (fread(base + sizeof(img), 1, len - sizeof(img), file) != len - sizeof(img)) {
+      free(base);
+      return (vfm_errno = VFM_FILE_ERR);
+    }
+  }
+
+  // Check relocations; pointer and target within the image
+  rp = (unsigned*) (base + img.reloc);
+  for (i = 0; i < img.relocs; i++)
+    if (rp[i] > img.reloc - sizeof(char*)
+	|| (unsigned long) *(char**) (base + rp[i]) >= img.reloc) {
+      if (mapped)
+	munmap(base, len);
+      else
+	free(base);
+      return (vfm_errno = VFM_FILE_ERR);
+    }
+
+  // Relocate pointers by base address
+  for (i = 0; i < img.relocs; i++)
+    *(char**) (base + rp[i]) += (long) base;
+
+  // Root module, entry and data heap
+  *mod = (vfm_mod_t*) (base + img.root);
+  if (entry) *entry = (img.entry ? base + img.entry : 0);
+  if (heap) *heap = (vfm_data_t*) (base + img.heap);
+  if (size) *size = img.heapsize;
+
+  return (vfm_errno = VFM_NOERR);
+}
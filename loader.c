@@ -17,228 +17,1252 @@
 #include "vfm.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <endian.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <sched.h>
 
-// TODO: Allow memory management control
 // TODO: Better support runtime and compile use cases
 // TODO: Enhance loading modes; full (0), object (1) or symbols (-1)
 
-#define LOADED_MAX 256
-#define NAME_MAX 256
+// NB: Object image; the object file is memory mapped and the code
+// NB: segment and names point into the mapping. Pages are shared with
+// NB: other processes mapping the same file until written; only pages
+// NB: with variables are copied. Counters, symbol tables and indexes are
+// NB: in the module arena. Mapping is from the page before the object;
+// NB: archive members are page aligned (VFM_ARC_ALIGN). Streams that
+// NB: cannot be mapped (fmemopen) are read into a buffer.
 
-static int load(FILE* file, int debug, vfm_mod_t *mod, vfm_arc_t *arc)
+// NB: Code is not mapped read-only (shared). Variables are allocated in
+// NB: the code segment by the compiler (variable, create) and written by
+// NB: the program, so the mapping is private and writable (copy on
+// NB: write). Read-only code requires a data segment in the object file.
+
+#define IMAGE_PROT (PROT_READ | PROT_WRITE)
+#define IMAGE_FLAGS MAP_PRIVATE
+
+static char* image(FILE* file, int size, vfm_image_t* img)
 {
-  static vfm_mod_t* loaded[LOADED_MAX] = { 0 };
-  vfm_code_t* code;
+  long pagesize = sysconf(_SC_PAGESIZE);
+  struct stat st;
+  long pos;
+  long base;
+  char* mp;
+
+  pos = ftell(file);
+  if (pos >= 0 && fileno(file) >= 0 && !fstat(fileno(file), &st)
+      && S_ISREG(st.st_mode) && pos + size <= st.st_size) {
+    base = pos & ~(pagesize - 1);
+    mp = mmap(0, size + (pos - base), IMAGE_PROT, IMAGE_FLAGS, 
+	      fileno(file), base);
+    if (mp != MAP_FAILED) {
+      img->base = mp;
+      img->size = size + (pos - base);
+      img->offset = pos - base;
+      img->mapped = VFM_IMAGE_MAPPED;
+      return (mp + (pos - base));
+    }
+  }
+  mp = (char*) malloc(size);
+  if (!mp || fread(mp, 1, size, file) != size) {
+    free(mp);
+    return (0);
+  }
+  img->base = mp;
+  img->size = size;
+  img->offset = 0;
+  img->mapped = VFM_IMAGE_READ;
+  return (mp);
+}
+
+// NB: Module arena; use list and tables are allocated from
+// NB: zeroed blocks. The first is sized from the object header so that
+// NB: a load is a single block. Blocks are chained (link first in block)
+// NB: when symbols are loaded on demand. Allocations are aligned
+// NB: (VFM_OBJ_ALIGN). The blocks are freed when unloaded.
+
+#define ARENA_LINK VFM_OBJ_ALIGN
+
+static int align(int size)
+{
+  return ((size + VFM_OBJ_ALIGN - 1) & ~(VFM_OBJ_ALIGN - 1));
+}
+
+static int reserve(vfm_arena_t* arena, int size)
+{
+  char* block;
+
+  if (arena->base && arena->count + size <= arena->size) 
+    return (VFM_NOERR);
+  block = (char*) calloc(ARENA_LINK + size, 1);
+  if (!block) return (VFM_MALLOC_ERR);
+  *(char**) block = arena->base;
+  arena->base = block;
+  arena->size = ARENA_LINK + size;
+  arena->count = ARENA_LINK;
+  return (VFM_NOERR);
+}
+
+static void* alloc(vfm_arena_t* arena, int size)
+{
+  char* res = arena->base + arena->count;
+  arena->count += align(size);
+  return (res);
+}
+
+static void clear(vfm_arena_t* arena)
+{
+  char* block;
+
+  while ((block = arena->base) != 0) {
+    arena->base = *(char**) block;
+    free(block);
+  }
+}
+
+// NB: Used modules are registered by name and reference counted by the
+// NB: modules that use them. Modules loaded by the caller (vfm_load) are
+// NB: not registered. Unloading releases the used modules and unloads
+// NB: those no longer referenced. The registry is hashed on name and
+// NB: guarded by a mutex. A module is entered before it is loaded; other
+// NB: loaders of the same module wait until it is published. A failed
+// NB: load is removed so that waiting loaders retry. With lazy loading
+// NB: modules are entered as stubs and loaded on first call (resolve).
+// NB: Each entry keeps the use list slots that reference the module and
+// NB: the modules (users) they are in so that a reload can switch them
+// NB: to the new version and relink the calls (vfm_reload).
+
+#define REGISTRY_MAX 1024
+
+#define ENTRY_LOADING 0
+#define ENTRY_LOADED 1
+#define ENTRY_STUB 2
+
+typedef struct entry_t {
+  struct entry_t* next;
+  char* name;
+  vfm_mod_t* mod;
+  vfm_mod_t*** slot;
+  vfm_mod_t** user;
+  int slots;
+  int size;
+  int state;
+  int debug;
+} entry_t;
+
+int vfm_lazy = 0;
+
+static entry_t* registry[REGISTRY_MAX];
+static entry_t* retired = 0;
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t registry_cond = PTHREAD_COND_INITIALIZER;
+
+static unsigned hash(char* name)
+{
+  unsigned h = 0;
+  while (*name) h = h * 31 + (unsigned char) *name++;
+  return (h % REGISTRY_MAX);
+}
+
+static entry_t** lookup(char* name)
+{
+  entry_t** ep;
+
+  for (ep = &registry[hash(name)]; *ep; ep = &(*ep)->next)
+    if (!strcmp((*ep)->name, name))
+      break;
+  return (ep);
+}
+
+static int attach(entry_t* entry, vfm_mod_t** slot, vfm_mod_t* user)
+{
+  vfm_mod_t*** sp;
+  vfm_mod_t** up;
+  int size;
+
+  if (entry->slots == entry->size) {
+    size = (entry->size ? 2 * entry->size : 4);
+    sp = (vfm_mod_t***) realloc(entry->slot, sizeof(vfm_mod_t**) * size);
+    if (!sp) return (VFM_MALLOC_ERR);
+    entry->slot = sp;
+    up = (vfm_mod_t**) realloc(entry->user, sizeof(vfm_mod_t*) * size);
+    if (!up) return (VFM_MALLOC_ERR);
+    entry->user = up;
+    entry->size = size;
+  }
+  entry->user[entry->slots] = user;
+  entry->slot[entry->slots++] = slot;
+  return (VFM_NOERR);
+}
+
+static void detach(entry_t* entry, vfm_mod_t** slot)
+{
+  int i;
+
+  for (i = 0; i < entry->slots; i++)
+    if (entry->slot[i] == slot) {
+      entry->slots -= 1;
+      entry->slot[i] = entry->slot[entry->slots];
+      entry->user[i] = entry->user[entry->slots];
+      return;
+    }
+}
+
+// NB: Set the user of the use list slots of a module that has been
+// NB: moved (resolve of a stub); called with the registry locked
+
+static void rebind(vfm_mod_t* mod)
+{
+  entry_t* entry;
+  int i;
+  int j;
+
+  for (i = 0; i < mod->use.count; i++) {
+    if (!mod->use.mod[i]) continue;
+    entry = *lookup(mod->use.mod[i]->name);
+    for (j = 0; entry && j < entry->slots; j++)
+      if (entry->slot[j] == &mod->use.mod[i])
+	entry->user[j] = mod;
+  }
+}
+
+static void drop(entry_t* entry)
+{
+  free(entry->name);
+  free(entry->mod);
+  free(entry->slot);
+  free(entry->user);
+  free(entry);
+}
+
+// NB: Acquire a reference to a used module. Returns zero when loaded
+// NB: (or stub), one when entered and to be loaded by the caller, and
+// NB: two when loaded by another loader (and not wait). Negative on error.
+
+static int acquire(char* name, vfm_mod_t** mod, vfm_mod_t* user, int wait)
+{
+  entry_t** ep;
+  entry_t* entry;
+
+  pthread_mutex_lock(&registry_lock);
+  for (ep = lookup(name); *ep && (*ep)->state == ENTRY_LOADING; ep = lookup(name)) {
+    if (!wait) {
+      pthread_mutex_unlock(&registry_lock);
+      return (2);
+    }
+    pthread_cond_wait(&registry_cond, &registry_lock);
+  }
+  if (*ep) {
+    if (attach(*ep, mod, user)) {
+      pthread_mutex_unlock(&registry_lock);
+      return (VFM_MALLOC_ERR);
+    }
+    (*ep)->mod->refs += 1;
+    *mod = (*ep)->mod;
+    pthread_mutex_unlock(&registry_lock);
+    return (0);
+  }
+  entry = (entry_t*) calloc(1, sizeof(entry_t));
+  if (entry) {
+    entry->name = strdup(name);
+    entry->mod = (vfm_mod_t*) calloc(1, sizeof(vfm_mod_t));
+    entry->state = ENTRY_LOADING;
+    if (!entry->name || !entry->mod || attach(entry, mod, user)) {
+      drop(entry);
+      entry = 0;
+    }
+  }
+  if (!entry) {
+    pthread_mutex_unlock(&registry_lock);
+    return (VFM_MALLOC_ERR);
+  }
+  entry->next = 0;
+  *ep = entry;
+  *mod = entry->mod;
+  pthread_mutex_unlock(&registry_lock);
+  return (1);
+}
+
+static void publish(char* name, int res)
+{
+  entry_t** ep;
+  entry_t* entry;
+
+  pthread_mutex_lock(&registry_lock);
+  ep = lookup(name);
+  entry = *ep;
+  if (res == 0) {
+    entry->mod->refs = 1;
+    entry->state = ENTRY_LOADED;
+  } else {
+    *ep = entry->next;
+    drop(entry);
+  }
+  pthread_cond_broadcast(&registry_cond);
+  pthread_mutex_unlock(&registry_lock);
+}
+
+static void stub(char* name, time_t timestamp, int debug)
+{
+  entry_t* entry;
+
+  pthread_mutex_lock(&registry_lock);
+  entry = *lookup(name);
+  entry->mod->name = entry->name;
+  entry->mod->ident = "";
+  entry->mod->version = "";
+  entry->mod->timestamp = timestamp;
+  entry->mod->ltab.file = "";
+  entry->mod->refs = 1;
+  entry->debug = debug;
+  entry->state = ENTRY_STUB;
+  pthread_cond_broadcast(&registry_cond);
+  pthread_mutex_unlock(&registry_lock);
+}
+
+static void release(vfm_mod_t* mod)
+{
+  entry_t** ep;
+  entry_t* entry;
+  vfm_mod_t* use;
+  int i;
+
+  // Release used modules; unload when no longer referenced
+  for (i = 0; i < mod->use.count; i++) {
+    use = mod->use.mod[i];
+    if (!use) continue;
+    pthread_mutex_lock(&registry_lock);
+    ep = lookup(use->name);
+    entry = *ep;
+    detach(entry, &mod->use.mod[i]);
+    if (--use->refs > 0) {
+      pthread_mutex_unlock(&registry_lock);
+      continue;
+    }
+    *ep = entry->next;
+    pthread_mutex_unlock(&registry_lock);
+    release(use);
+    drop(entry);
+  }
+
+  // Unmap or free object image and free arena; archive mapping is kept
+  if (mod->image.mapped == VFM_IMAGE_MAPPED)
+    munmap(mod->image.base, mod->image.size);
+  else if (mod->image.mapped == VFM_IMAGE_READ)
+    free(mod->image.base);
+  free(mod->segment.refcnt);
+  clear(&mod->arena);
+  memset(mod, 0, sizeof(vfm_mod_t));
+}
+
+// NB: Used modules that are not loaded are loaded in parallel; each on
+// NB: a loader thread while there are free (LOADER_MAX), otherwise by
+// NB: the calling thread. Members of archives that are not mapped are
+// NB: loaded by the calling thread as the archive file position is shared.
+
+#define LOADER_MAX 8
+
+typedef struct task_t {
+  pthread_t thread;
+  char* name;
+  vfm_mod_t* mod;
+  FILE* file;
+  vfm_arc_t* arc;
+  int debug;
+  int state;
+  int spawned;
+  int res;
+} task_t;
+
+static int loaders = 0;
+
+static void* run_task(void* arg);
+
+static void* load_use(void* arg)
+{
+  task_t* task = (task_t*) arg;
+  char filename[FILENAME_MAX];
+  FILE* file;
+
+  // Load module file and publish result
+  strcpy(filename, task->name);
+  strcat(vfm_name2path(filename), ".vfm");
+  file = fopen(filename, "r");
+  if (!file) {
+    fprintf(stderr, "%s: error: missing module file\n", filename);
+    task->res = VFM_MODULE_LOOKUP_ERR;
+  } else {
+    task->res = vfm_load(file, task->debug, task->mod);
+    fclose(file);
+  }
+  publish(task->name, task->res);
+  return (0);
+}
+
+static int spawn(task_t* task)
+{
+  pthread_mutex_lock(&registry_lock);
+  task->spawned = (loaders < LOADER_MAX);
+  if (task->spawned) loaders += 1;
+  pthread_mutex_unlock(&registry_lock);
+  if (task->spawned && pthread_create(&task->thread, 0, run_task, task)) {
+    pthread_mutex_lock(&registry_lock);
+    loaders -= 1;
+    pthread_mutex_unlock(&registry_lock);
+    task->spawned = 0;
+  }
+  return (task->spawned);
+}
+
+static void load_task(task_t* task, FILE* file, vfm_arc_t* arc)
+{
+  // Check for archive based loading, fallback to file loading
+  if (arc && !vfm_arc_load(file, task->name, task->debug, task->mod, arc)) {
+    task->res = VFM_NOERR;
+    publish(task->name, task->res);
+    return;
+  }
+  load_use(task);
+}
+
+static void* run_task(void* arg)
+{
+  task_t* task = (task_t*) arg;
+
+  load_task(task, task->file, task->arc);
+  return (0);
+}
+
+static void join(task_t* task)
+{
+  if (!task->spawned) return;
+  pthread_join(task->thread, 0);
+  pthread_mutex_lock(&registry_lock);
+  loaders -= 1;
+  pthread_mutex_unlock(&registry_lock);
+}
+
+static int fail(vfm_mod_t* mod, int err)
+{
+  release(mod);
+  return (vfm_errno = err);
+}
+
+static unsigned u32(char* op, unsigned offset)
+{
+  return (be32toh(*(unsigned*) (op + offset)));
+}
+
+static int header(vfm_obj_t* obj)
+{
+  unsigned* fp;
+
+  if (strncmp(obj->magic, VFM_OBJ_MAGIC, sizeof(obj->magic))) 
+    return (VFM_MAGIC_ERR);
+  for (fp = &obj->size; fp <= &obj->strings; fp++) *fp = be32toh(*fp);
+  if (obj->size < sizeof(*obj) || obj->code + obj->codesize > obj->size)
+    return (VFM_FILE_ERR);
+  return (VFM_NOERR);
+}
+
+// NB: Symbol table, name index (power of two buckets) and source line
+// NB: table; loaded with the module (debug) or on demand
+// NB: (vfm_load_symbols). Names are in the image.
+
+static int buckets(vfm_obj_t* obj)
+{
+  int res;
+
+  for (res = 1; res < obj->symbols; res *= 2);
+  return (res);
+}
+
+static int symbols_size(vfm_obj_t* obj)
+{
+  return (align(sizeof(vfm_symb_t) * obj->symbols)
+	  + 2 * align(sizeof(int) * buckets(obj))
+	  + align(sizeof(vfm_line_t) * obj->lines));
+}
+
+static void symbols(vfm_mod_t* mod, vfm_obj_t* obj, char* op)
+{
+  char* strings = op + obj->strings;
   vfm_symb_t* symb;
-  char name[NAME_MAX];
+  vfm_line_t* line;
+  unsigned* fp;
+  int count;
+  int i;
+
+  // Symbol table
+  count = obj->symbols;
+  symb = (vfm_symb_t*) alloc(&mod->arena, sizeof(vfm_symb_t) * count);
+  mod->dict.count = count;
+  mod->dict.size = count;
+  mod->dict.symbols = symb;
+  for (i = 0; i < count; i++, symb++) {
+    fp = (unsigned*) (op + obj->symbol) + i * 3;
+    symb->name = strings + be32toh(fp[0]);
+    symb->code = mod->segment.code + be32toh(fp[1]);
+    symb->mode = be32toh(fp[2]);
+  }
+
+  // Name index in arena; sized for all symbols so it is never rebuilt
+  mod->dict.buckets = buckets(obj);
+  mod->dict.bucket = (int*) alloc(&mod->arena, sizeof(int) * mod->dict.buckets);
+  mod->dict.chain = (int*) alloc(&mod->arena, sizeof(int) * mod->dict.buckets);
+  for (i = 0; i < mod->dict.buckets; i++)
+    mod->dict.bucket[i] = -1;
+  vfm_dict_index(&mod->dict);
+
+  // Source line table; file, count and lines. May be stripped
+  count = obj->lines;
+  if (count == 0) return;
+  line = (vfm_line_t*) alloc(&mod->arena, sizeof(vfm_line_t) * count);
+  mod->ltab.count = count;
+  mod->ltab.size = count;
+  mod->ltab.file = strings + obj->file;
+  mod->ltab.lines = line;
+  for (i = 0; i < count; i++, line++) {
+    line->offset = u32(op, obj->line + i * 2 * sizeof(unsigned));
+    line->line = u32(op, obj->line + (i * 2 + 1) * sizeof(unsigned));
+  }
+}
+
+static int load(FILE* file, char* member, int debug, vfm_mod_t *mod, vfm_arc_t *arc)
+{
+  vfm_obj_t obj;
+  char* strings;
+  char* op;
   int timestamp;
   int count;
-  int entry;
-  int load;
   int size;
-  int offset;
-  int mode;
-  int res;
+  int err;
   int i;
-  int j;
 
-  // Reset error number
+  // Reset error number and module
   vfm_errno = VFM_NOERR;
+  memset(mod, 0, sizeof(vfm_mod_t));
 
-  // Read header and check magic string
-  
-  if (!fgets(name, sizeof(name), file) || strcmp(name, VFM_OBJ_MAGIC)) 
+  // Read header and check magic string; member of mapped archive or file
+  if (member)
+    memcpy(&obj, member, sizeof(obj));
+  else if (fread(&obj, sizeof(obj), 1, file) != 1) 
     return (vfm_errno = VFM_MAGIC_ERR);
+  err = header(&obj);
+  if (err) return (vfm_errno = err);
+
+  // Object image in archive mapping, or map or read object file
+  if (member) {
+    if (obj.size > arc->base + arc->size - member)
+      return (vfm_errno = VFM_MAGIC_ERR);
+    op = member;
+    mod->image.base = member;
+    mod->image.size = obj.size;
+    mod->image.mapped = VFM_IMAGE_ARCHIVE;
+  } else {
+    fseek(file, -sizeof(obj), SEEK_CUR);
+    op = image(file, obj.size, &mod->image);
+    if (!op) return (vfm_errno = VFM_FILE_ERR);
+  }
+  strings = op + obj.strings;
 
-  // Read module name, version and timestamp
-  fgetstr(name, file);
-  mod->name = strdup(name);
-  fgetstr(name, file);
-  mod->ident = strdup(name);
-  fgetstr(name, file);
-  mod->version = strdup(name);
-  fgetint(&timestamp, file);
-  mod->timestamp = (time_t) timestamp;
-
-  // Read use module list and load modules when needed
-  fgetint(&count, file);
-  mod->use.count = mod->use.size = count;
-  mod->use.mod = 0;
+  // Allocate arena; use list and in debug mode symbol tables
+  size = align(sizeof(vfm_mod_t*) * (obj.uses + 1));
+  if (debug) size += symbols_size(&obj);
+  if (reserve(&mod->arena, size)) return (fail(mod, VFM_MALLOC_ERR));
+
+  // Module name, version and timestamp
+  mod->name = strings + obj.name;
+  mod->ident = strings + obj.ident;
+  mod->version = strings + obj.version;
+  mod->timestamp = (time_t) obj.timestamp;
+
+  // Use module list; load modules when needed. Modules not referenced
+  // (errors) are null so that errors release the others
+  count = obj.uses;
+  mod->use.size = count;
+  mod->use.count = count;
   if (count > 0) {
     vfm_mod_t** use;
+    task_t* task;
     char filename[FILENAME_MAX];
-    FILE* usefile;
+    int loads = 0;
+    int res = VFM_NOERR;
+
+    use = mod->use.mod = (vfm_mod_t**) 
+      alloc(&mod->arena, sizeof(vfm_mod_t*) * (count + 1));
+    task = (task_t*) calloc(count, sizeof(task_t));
+    if (!task) return (fail(mod, VFM_MALLOC_ERR));
 
-    use = (vfm_mod_t**) malloc(sizeof(vfm_mod_t*) * (count + 1));
-    if (!use) return (vfm_errno = VFM_MALLOC_ERR);
+    // Acquire loaded modules and enter modules to load
+    for (i = 0; i < count && !res; i++) {
+      task[i].name = strings + u32(op, obj.use + i * 2 * sizeof(unsigned));
+      task[i].debug = debug;
+      task[i].file = file;
+      task[i].arc = arc;
+      task[i].state = acquire(task[i].name, &use[i], mod, 0);
+      if (task[i].state < 0) res = task[i].state;
+      if (task[i].state == 1 && vfm_lazy && !arc) {
+	timestamp = u32(op, obj.use + (i * 2 + 1) * sizeof(unsigned));
+	stub(task[i].name, (time_t) timestamp, debug);
+	task[i].state = 0;
+      }
+      if (task[i].state == 1) loads += 1;
+    }
 
-    // Read module name, check if already loaded
+    // Load entered modules; in parallel when more than one
     for (i = 0; i < count; i++) {
+      if (task[i].state != 1) continue;
+      task[i].mod = use[i];
+      if (res) {
+	publish(task[i].name, task[i].res = res);
+	continue;
+      }
+      if ((arc && arc->mapped == VFM_ARC_READ) || loads == 1 || !spawn(&task[i])) 
+	load_task(&task[i], file, arc);
+    }
+    for (i = 0; i < count; i++) 
+      join(&task[i]);
 
-      // Read full module name
-      fgetstr(name, file);
+    // Wait for modules loaded by other loaders; load if they failed
+    for (i = 0; i < count && !res; i++) {
+      if (task[i].state != 2) continue;
+      task[i].state = acquire(task[i].name, &use[i], mod, 1);
+      if (task[i].state < 0) res = task[i].state;
+      if (task[i].state != 1) continue;
+      task[i].mod = use[i];
+      load_task(&task[i], file, arc);
+    }
 
-      // Check if already loaded
-      for (j = 0; j < LOADED_MAX && loaded[j]; j++)
-	if (!strcmp(loaded[j]->name, name))
-	  break;
-      if (j == LOADED_MAX) {
-	fprintf(stderr, "error: module limit exceeded\n");
-	return (vfm_errno = VFM_MODULE_LIMIT_ERR);
-      }
-      if (loaded[j]) {
-	use[i] = loaded[j];
-	fgetint(&timestamp, file);
+    // Check loaded modules and compile timestamp
+    for (i = 0; i < count; i++) {
+      if (task[i].state != 1) continue;
+      if (task[i].res) {
+	use[i] = 0;
+	if (!res) res = task[i].res;
 	continue;
       }
+      timestamp = u32(op, obj.use + (i * 2 + 1) * sizeof(unsigned));
+      if (use[i]->timestamp != timestamp && !res) {
+	strcpy(filename, task[i].name);
+	strcat(vfm_name2path(filename), ".vfm");
+	fprintf(stderr, "%s: error: compile timestamp\n", filename);
+	res = VFM_MODULE_TIMESTAMP_ERR;
+      }
+    }
+    free(task);
+    if (res) return (fail(mod, res));
+  }
 
-      // Load the module data
-      loaded[j] = use[i] = (vfm_mod_t*) malloc(sizeof(vfm_mod_t));
-      if (!use[i]) return (vfm_errno = VFM_MALLOC_ERR);
+  // Setup module segment data; code in image
+  mod->segment.size = obj.codesize;
+  mod->segment.count = obj.codesize;
+  mod->segment.code = op + obj.code;
+  mod->segment.entry = (obj.entry != 0 ? mod->segment.code + obj.entry : 0);
 
-      // Check for archive based loading, fallback to file loading
-      load = 1;
-      if (arc) {
-	int pos = ftell(file);
-	if (!vfm_arc_load(file, name, debug, use[i], arc)) {
-	  load = 0;
-	}
-	fseek(file, pos, SEEK_SET);
-      }
+  // Empty dictionary and source line table (module is zeroed)
+  mod->ltab.file = "";
 
-      // Normal file loading. Load module into allocated (loaded[j])
-      if (load) {
-	sprintf(filename, "%s.vfm", vfm_name2path(name));
-	usefile = fopen(filename, "r");
-	if (!usefile) {
-	  fprintf(stderr, "%s: error: missing module file\n", filename);
-	  return (vfm_errno = VFM_MODULE_LOOKUP_ERR);
-	}
+  // Load symbol tables in debug mode, otherwise on demand
+  if (debug)
+    symbols(mod, &obj, op);
+  else
+    mod->dict.pending = mod;
 
-	// Load module file and cascade errors
-	if (vfm_load(usefile, debug, use[i]) != 0) {
-	  fclose(usefile);
-	  return (vfm_errno);
-	}
-	fclose(usefile);
-      }
+  return (0);
+}
 
-      // Check compile timestamp
-      fgetint(&timestamp, file);
-      if (use[i]->timestamp != timestamp) {
-	fprintf(stderr, "%s: error: compile timestamp\n", filename);
-	return (vfm_errno = VFM_MODULE_TIMESTAMP_ERR);
+int vfm_load(FILE* file, int debug, vfm_mod_t *mod)
+{
+  return (load(file, 0, debug, mod, 0));
+}
+
+int vfm_unload(vfm_mod_t *mod)
+{
+  if (!mod) return (vfm_errno = VFM_ERR);
+
+  // Used modules are unloaded when no longer referenced
+  if (mod->refs > 0) return (vfm_errno = VFM_MODULE_USED_ERR);
+  if (!mod->image.base) return (vfm_errno = VFM_ERR);
+  release(mod);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+int vfm_resolve(vfm_mod_t *mod)
+{
+  if (!mod) return (vfm_errno = VFM_ERR);
+
+  char filename[FILENAME_MAX];
+  vfm_code_t* code;
+  vfm_mod_t tmp;
+  entry_t* entry;
+  FILE* file;
+  int res;
+
+  // Check that the module is a stub; wait while loaded by another
+  pthread_mutex_lock(&registry_lock);
+  for (entry = *lookup(mod->name); 
+       entry && entry->mod == mod && entry->state == ENTRY_LOADING; 
+       entry = *lookup(mod->name))
+    pthread_cond_wait(&registry_cond, &registry_lock);
+  if (!entry || entry->mod != mod || entry->state == ENTRY_LOADED) {
+    pthread_mutex_unlock(&registry_lock);
+    return (vfm_errno = (VFM_LOADED(mod) ? VFM_NOERR : VFM_ERR));
+  }
+  entry->state = ENTRY_LOADING;
+  pthread_mutex_unlock(&registry_lock);
+
+  // Load module file and check compile timestamp
+  strcpy(filename, entry->name);
+  strcat(vfm_name2path(filename), ".vfm");
+  file = fopen(filename, "r");
+  if (!file) {
+    fprintf(stderr, "%s: error: missing module file\n", filename);
+    res = VFM_MODULE_LOOKUP_ERR;
+  } else {
+    res = vfm_load(file, entry->debug, &tmp);
+    fclose(file);
+  }
+  if (!res && tmp.timestamp != mod->timestamp) {
+    fprintf(stderr, "%s: error: compile timestamp\n", filename);
+    vfm_unload(&tmp);
+    res = VFM_MODULE_TIMESTAMP_ERR;
+  }
+
+  // Fill in stub; code segment last as it marks the module loaded.
+  // The stub is kept on errors so that the next call retries
+  pthread_mutex_lock(&registry_lock);
+  if (!res) {
+    code = tmp.segment.code;
+    mod->name = tmp.name;
+    mod->ident = tmp.ident;
+    mod->version = tmp.version;
+    mod->use = tmp.use;
+    mod->dict = tmp.dict;
+    if (mod->dict.pending) mod->dict.pending = mod;
+    mod->ltab = tmp.ltab;
+    mod->image = tmp.image;
+    mod->arena = tmp.arena;
+    mod->segment.count = tmp.segment.count;
+    mod->segment.size = tmp.segment.size;
+    mod->segment.entry = tmp.segment.entry;
+    mod->segment.refcnt = tmp.segment.refcnt;
+    rebind(mod);
+    __atomic_store_n(&mod->segment.code, code, __ATOMIC_RELEASE);
+    entry->state = ENTRY_LOADED;
+  } else {
+    entry->state = ENTRY_STUB;
+  }
+  pthread_cond_broadcast(&registry_cond);
+  pthread_mutex_unlock(&registry_lock);
+
+  return (vfm_errno = res);
+}
+
+// NB: Load symbol tables from image; pending is cleared last. Called
+// NB: with the registry locked
+
+static int pending(vfm_mod_t* mod)
+{
+  vfm_obj_t obj;
+  char* op;
+  int res = VFM_NOERR;
+
+  if (mod->dict.pending) {
+    op = mod->image.base + mod->image.offset;
+    memcpy(&obj, op, sizeof(obj));
+    res = header(&obj);
+    if (!res) res = reserve(&mod->arena, symbols_size(&obj));
+    if (!res) {
+      symbols(mod, &obj, op);
+      __atomic_store_n(&mod->dict.pending, 0, __ATOMIC_RELEASE);
+    }
+  }
+  return (res);
+}
+
+int vfm_load_symbols(vfm_mod_t *mod)
+{
+  if (!mod) return (vfm_errno = VFM_ERR);
+
+  int res;
+
+  pthread_mutex_lock(&registry_lock);
+  res = pending(mod);
+  pthread_mutex_unlock(&registry_lock);
+
+  return (vfm_errno = res);
+}
+
+// NB: Safepoint; running environments are stopped at a request poll
+// NB: (run, function and module call, backward branch) with the state
+// NB: saved in the environment (vfm_park). The world is stopped when all
+// NB: running environments (vfm_tasks) are parked. Environments that
+// NB: are not running have saved their state on return from run.
+
+static pthread_mutex_t stop_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t park_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t park_cond = PTHREAD_COND_INITIALIZER;
+static int parked = 0;
+
+int vfm_park(vfm_env_t* env)
+{
+  if (!env) return (vfm_errno = VFM_ERR);
+
+  pthread_mutex_lock(&park_lock);
+  parked += 1;
+  while (vfm_request & VFM_SAFEPOINT_REQUEST)
+    pthread_cond_wait(&park_cond, &park_lock);
+  parked -= 1;
+  pthread_mutex_unlock(&park_lock);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+static void stop(void)
+{
+  pthread_mutex_lock(&stop_lock);
+  __sync_fetch_and_or(&vfm_request, VFM_SAFEPOINT_REQUEST);
+  pthread_mutex_lock(&park_lock);
+  while (parked != vfm_tasks) {
+    pthread_mutex_unlock(&park_lock);
+    sched_yield();
+    pthread_mutex_lock(&park_lock);
+  }
+  pthread_mutex_unlock(&park_lock);
+}
+
+static void start(void)
+{
+  pthread_mutex_lock(&park_lock);
+  __sync_fetch_and_and(&vfm_request, ~VFM_SAFEPOINT_REQUEST);
+  pthread_cond_broadcast(&park_cond);
+  pthread_mutex_unlock(&park_lock);
+  pthread_mutex_unlock(&stop_lock);
+}
+
+// NB: Reload switches the use list slots of the dependants to the new
+// NB: version at a safepoint. Frames in the old version finish on the
+// NB: old code and modules. The symbols of the old version must be at
+// NB: the same index in the new version (symbol index calls, MESTI);
+// NB: new symbols are appended. When the code offsets differ the module
+// NB: calls (MEST) of the dependants are relinked to the new offsets.
+// NB: The old version is retired and reclaimed when not referenced by
+// NB: the given environments (vfm_reclaim). Loading of modules that use
+// NB: the module should not run concurrently.
+
+static int validate(vfm_mod_t* mod, vfm_mod_t* next)
+{
+  vfm_symb_t* old;
+  vfm_symb_t* sp;
+  int moved = 0;
+  int i;
+
+  // Same module and not older; used modules are checked by load
+  if (strcmp(mod->name, next->name)) return (VFM_MODULE_LOOKUP_ERR);
+  if (next->timestamp < mod->timestamp) return (VFM_MODULE_TIMESTAMP_ERR);
+
+  // Symbols of old version at same index; returns one when moved
+  if (next->dict.count < mod->dict.count) return (VFM_MODULE_LAYOUT_ERR);
+  for (i = 0; i < mod->dict.count; i++) {
+    old = &mod->dict.symbols[i];
+    sp = &next->dict.symbols[i];
+    if (strcmp(old->name, sp->name)) return (VFM_MODULE_LAYOUT_ERR);
+    if (old->code - mod->segment.code != sp->code - next->segment.code)
+      moved = 1;
+  }
+  return (moved);
+}
+
+// NB: Relink the module calls (MEST) of a user with the given use index
+// NB: from the old to the new version; the call offset is mapped by
+// NB: symbol index. The code is decoded per symbol (as vfm_opusage).
+// NB: Checked first (no write) so that a call that is not to a symbol,
+// NB: or a new offset that does not fit the operand, fails the reload
+// NB: before any code is changed. Called with the registry locked and
+// NB: the world stopped.
+
+static int relink(vfm_mod_t* user, int index, vfm_mod_t* mod, vfm_mod_t* next, int write)
+{
+  vfm_code_t* code = user->segment.code;
+  vfm_symb_t* symb;
+  vfm_code_t* end;
+  vfm_code_t* ip;
+  vfm_symb_t* sp;
+  int offset;
+  int res;
+  int op;
+  int i;
+  int j;
+
+  // User module not loaded (stub) or being loaded
+  if (!code) return (VFM_NOERR);
+  if ((res = pending(user))) return (res);
+  symb = user->dict.symbols;
+
+  for (i = 0; i < user->dict.count; i++) {
+
+    // End is the index byte of the following symbol
+    end = code + user->segment.size;
+    for (j = 0; j < user->dict.count; j++)
+      if (symb[j].code > symb[i].code && symb[j].code - 1 < end)
+	end = symb[j].code - 1;
+
+    // Decode operations; data follows create and variable (UNSLIT)
+    for (ip = symb[i].code; ip < end; ) {
+      if (*ip < 0) {
+	ip += 2;
+	continue;
       }
+      op = *ip;
+      if (op == VFM_OP_UNSLIT) break;
+      if (op == VFM_OP_NNEST || op == VFM_OP_SLIT) {
+	ip += 2 + (ip[1] & 0xff);
+	continue;
+      }
+      if (op == VFM_OP_MEST && ip + 4 < end && ip[1] == index 
+	  && ip[4] == VFM_OP_UNMEST) {
+	offset = (ip[2] << 8) | (ip[3] & 0xff);
+	sp = vfm_addr2symb(mod->segment.code + offset, &mod->dict);
+	if (!sp || sp->code != mod->segment.code + offset)
+	  return (VFM_MODULE_LAYOUT_ERR);
+	offset = next->dict.symbols[sp - mod->dict.symbols].code 
+	  - next->segment.code;
+	if (offset > 0x7fff) return (VFM_MODULE_LAYOUT_ERR);
+	if (write) {
+	  ip[2] = (vfm_code_t) (offset >> 8);
+	  ip[3] = (vfm_code_t) (offset & 0xff);
+	}
+      }
+      ip += 1 + vfm_opsize(op);
     }
-    mod->use.mod = use;
-  }
-  // Read code area with entry and size
-  fgetint(&entry, file);
-  fgetint(&size, file);
-  code = (vfm_code_t*) malloc(sizeof(vfm_code_t) * size);
-  if (!code) return (vfm_errno = VFM_MALLOC_ERR);
-  res = fread(code, 1, size, file);
-  if (res != size) return (vfm_errno = VFM_FILE_ERR);
-
-  // Setup module segment data
-  mod->segment.size = size;
-  mod->segment.count = size;
-  mod->segment.code = code;
-  mod->segment.entry = (entry != 0 ? code + entry : 0);
-
-  // Initiate empty dictionary
-  mod->dict.count = 0;
-  mod->dict.size = 0;
-  mod->dict.symbols = 0;
-
-  // Check for non debug mode and skip symbol table load
-  if (!debug) return (0);
-
-  // Read symbol table; count and symbols
-  fgetint(&count, file);
-  symb = (vfm_symb_t*) malloc(sizeof(vfm_symb_t) * count);
-  if (!symb) return (vfm_errno = VFM_MALLOC_ERR);
-  mod->dict.count = count;
-  mod->dict.size = count;
-  mod->dict.symbols = symb;
-  for(i = 0; i < count; i++, symb++) {
-    fgetstr(name, file);
-    fgetint(&offset, file);
-    fgetint(&mode, file);
-    symb->name = strdup(name);
-    symb->code = code + offset;
-    symb->mode = mode;
-    symb->refcnt = 0;
   }
+  return (VFM_NOERR);
+}
 
-  return (0);
+int vfm_reload(vfm_mod_t *mod, FILE* file)
+{
+  if (!mod || !file) return (vfm_errno = VFM_ERR);
+
+  vfm_mod_t* next;
+  entry_t* entry;
+  entry_t* old;
+  int moved;
+  int res;
+  int i;
+
+  // Current version with symbol tables for the layout check
+  if (!VFM_LOADED(mod) && vfm_resolve(mod)) return (vfm_errno);
+  if (VFM_PENDING(&mod->dict) && vfm_load_symbols(mod)) return (vfm_errno);
+
+  // Load new version side by side and validate
+  next = (vfm_mod_t*) calloc(1, sizeof(vfm_mod_t));
+  old = (entry_t*) calloc(1, sizeof(entry_t));
+  if (!next || !old) {
+    free(next);
+    free(old);
+    return (vfm_errno = VFM_MALLOC_ERR);
+  }
+  res = load(file, 0, 1, next, 0);
+  if (!res) {
+    res = moved = validate(mod, next);
+    if (res > 0) res = VFM_NOERR;
+    if (res) release(next);
+  }
+  if (res) {
+    free(next);
+    free(old);
+    return (vfm_errno = res);
+  }
+
+  // Stop the world; the module must be a used module (registered)
+  stop();
+  pthread_mutex_lock(&registry_lock);
+  entry = *lookup(mod->name);
+  if (!entry || entry->mod != mod || entry->state != ENTRY_LOADED)
+    res = VFM_ERR;
+
+  // Relink the users when the code offsets have changed; check all
+  // before writing
+  for (i = 0; !res && moved && i < entry->slots; i++)
+    res = relink(entry->user[i], entry->slot[i] - entry->user[i]->use.mod, 
+		 mod, next, 0);
+  if (res) {
+    pthread_mutex_unlock(&registry_lock);
+    start();
+    release(next);
+    free(next);
+    free(old);
+    return (vfm_errno = res);
+  }
+  for (i = 0; moved && i < entry->slots; i++)
+    relink(entry->user[i], entry->slot[i] - entry->user[i]->use.mod, 
+	   mod, next, 1);
+
+  // Switch dependants, registry and references to new version
+  for (i = 0; i < entry->slots; i++)
+    __atomic_store_n(entry->slot[i], next, __ATOMIC_RELEASE);
+  next->refs = mod->refs;
+  mod->refs = 0;
+  entry->mod = next;
+  old->mod = mod;
+  old->next = retired;
+  retired = old;
+  pthread_mutex_unlock(&registry_lock);
+  start();
+
+  return (vfm_errno = VFM_NOERR);
 }
 
-int vfm_load(FILE* file, int debug, vfm_mod_t *mod)
+static int referenced(vfm_mod_t* mod, vfm_env_t* env)
 {
-  return (load(file, debug, mod, 0));
+  vfm_code_t* code = mod->segment.code;
+  vfm_code_t* end = code + mod->segment.size;
+  vfm_code_t** rp;
+
+  // Current module or instruction, or module and return address frames
+  if (env->mp == mod || (env->ip >= code && env->ip < end)) return (1);
+  for (rp = env->rp0; rp <= env->rp; rp++)
+    if (*rp == (vfm_code_t*) mod || (*rp >= code && *rp < end)) return (1);
+  return (0);
 }
 
-int vfm_arc_map_load(FILE* file, vfm_arc_t* arc)
+// NB: Reclaim checks the saved state of the environments at a safepoint
+// NB: so that running environments are included. All environments that
+// NB: may run code of a retired version must be given.
+
+int vfm_reclaim(vfm_env_t** env, int count)
 {
-  vfm_map_t* map;
-  char name[NAME_MAX];
-  char magic[256];
-  char ident[64];
-  char version[64];
-  int timestamp;
-  int objects;
-  int size;
-  int pos;
+  if (count > 0 && !env) return (vfm_errno = VFM_ERR);
+
+  entry_t** ep;
+  entry_t* entry;
+  entry_t* unused = 0;
   int i;
 
-  // Read magic signature and check
-  arc->count = 0;
-  if (!fgets(magic, sizeof(magic), file) || strcmp(magic, VFM_LIB_MAGIC)) 
-    return (vfm_errno = VFM_MAGIC_ERR);
+  // Collect retired modules not referenced by the environments
+  stop();
+  pthread_mutex_lock(&registry_lock);
+  for (ep = &retired; *ep; ) {
+    for (i = 0; i < count && !referenced((*ep)->mod, env[i]); i++);
+    if (i < count) {
+      ep = &(*ep)->next;
+      continue;
+    }
+    entry = *ep;
+    *ep = entry->next;
+    entry->next = unused;
+    unused = entry;
+  }
+  pthread_mutex_unlock(&registry_lock);
+  start();
 
-  // Read number of object files and names in archive header
-  fgetint(&objects, file);
-  arc->size = arc->count = objects;
-  map = arc->map = (vfm_map_t*) malloc(sizeof(vfm_map_t) * objects);
-  for (i = 0; i < objects; i++) {
-    fgetstr(name, file);
-    fgetstr(ident, file);
-    fgetstr(version, file);
-    fgetint(&timestamp, file);
-    fgetint(&size, file);
-    fgetint(&pos, file);
-    map[i].name = strdup(name);
-    map[i].ident = strdup(ident);
-    map[i].version = strdup(version);
-    map[i].timestamp = timestamp;
-    map[i].size = size;
-    map[i].pos = pos;
-  }
-
-  // Save position of first object file
-  arc->pos = ftell(file);
+  // Release retired modules and their used modules
+  while ((entry = unused) != 0) {
+    unused = entry->next;
+    release(entry->mod);
+    drop(entry);
+  }
 
   return (vfm_errno = VFM_NOERR);
 }
 
-int vfm_arc_load(FILE* file, char* name, int debug, vfm_mod_t *mod, vfm_arc_t* arc)
+// NB: Archive; the archive file is memory mapped (private, copy on write)
+// NB: and members are loaded in place. The mapping is kept for the loaded
+// NB: modules. Streams that cannot be mapped (fmemopen) read the header
+// NB: and tables; members are read from the file. An archive in memory
+// NB: (vfm_arc_init) is used as a mapping. Lookup is in the name index
+// NB: (hash) of the archive.
+
+#define LIB(arc, field) u32((arc)->base, offsetof(vfm_lib_t, field))
+#define MEMBER(arc, nr) ((arc)->base + LIB(arc, member) + (nr) * sizeof(vfm_member_t))
+#define FIELD(mp, field) u32(mp, offsetof(vfm_member_t, field))
+
+static int find(vfm_arc_t* arc, char* name)
+{
+  char* strings = arc->base + LIB(arc, strings);
+  unsigned h = vfm_strhash(name) & (arc->buckets - 1);
+  unsigned nr;
+  char* mp;
+  int steps;
+
+  // Chain is bound by the number of members; a cycle ends the search
+  for (nr = u32(arc->base, LIB(arc, bucket) + h * sizeof(unsigned)), steps = 0; 
+       nr > 0 && nr <= arc->count && steps < arc->count; 
+       nr = FIELD(mp, next), steps++) {
+    mp = MEMBER(arc, nr - 1);
+    if (!strcmp(name, strings + FIELD(mp, name))) return (nr - 1);
+  }
+  return (-1);
+}
+
+static int check(vfm_lib_t* lib)
+{
+  unsigned count = be32toh(lib->count);
+  unsigned buckets = be32toh(lib->buckets);
+  unsigned size = be32toh(lib->size);
+
+  // Check magic string and that the tables are within the header size
+  if (strncmp(lib->magic, VFM_LIB_MAGIC, sizeof(lib->magic))
+      || buckets == 0 || (buckets & (buckets - 1)) || size < sizeof(vfm_lib_t)
+      || be32toh(lib->member) + count * sizeof(vfm_member_t) > size
+      || be32toh(lib->bucket) + buckets * sizeof(unsigned) > size
+      || be32toh(lib->strings) > size)
+    return (VFM_MAGIC_ERR);
+  return (VFM_NOERR);
+}
+
+static int check_strings(char* base)
 {
+  vfm_lib_t* lib = (vfm_lib_t*) base;
+  unsigned count = be32toh(lib->count);
+  unsigned size = be32toh(lib->size);
+  unsigned strings = be32toh(lib->strings);
+  unsigned field[3] = { 
+    offsetof(vfm_member_t, name), 
+    offsetof(vfm_member_t, ident), 
+    offsetof(vfm_member_t, version)
+  };
+  unsigned offset;
+  char* mp;
   int i;
+  int j;
 
-  // Check that the archive header map is loaded
-  if (!arc->map && vfm_arc_map_load(file, arc))
-    return (vfm_errno);
+  // Check that member names are terminated strings within the header size
+  for (i = 0; i < count; i++) {
+    mp = base + be32toh(lib->member) + i * sizeof(vfm_member_t);
+    for (j = 0; j < 3; j++) {
+      offset = u32(mp, field[j]);
+      if (offset >= size - strings
+	  || !memchr(base + strings + offset, 0, size - strings - offset))
+	return (VFM_MAGIC_ERR);
+    }
+  }
+  return (VFM_NOERR);
+}
+
+int vfm_arc_map_load(FILE* file, vfm_arc_t* arc)
+{
+  if (!file || !arc) return (vfm_errno = VFM_ERR);
+
+  struct stat st;
+  vfm_lib_t lib;
+  char* base = MAP_FAILED;
+  unsigned size;
+
+  // Read header and check magic string and tables
+  memset(arc, 0, sizeof(vfm_arc_t));
+  if (fread(&lib, sizeof(lib), 1, file) != 1 || check(&lib))
+    return (vfm_errno = VFM_MAGIC_ERR);
+  size = be32toh(lib.size);
 
-  // Search through map and if found load object code
-  for (i = 0; i < arc->count; i++) 
-    if (!strcmp(name, arc->map[i].name)) {
-      fseek(file, arc->pos + arc->map[i].pos, SEEK_SET);
-      load(file, debug, mod, arc);
-      return (vfm_errno);
+  // Map archive file; fallback read of header and tables
+  if (!fstat(fileno(file), &st) && S_ISREG(st.st_mode) && st.st_size >= size)
+    base = mmap(0, st.st_size, IMAGE_PROT, IMAGE_FLAGS, fileno(file), 0);
+  if (base != MAP_FAILED) {
+    arc->size = st.st_size;
+    arc->mapped = VFM_ARC_MAPPED;
+  } else {
+    base = (char*) malloc(size);
+    if (!base) return (vfm_errno = VFM_MALLOC_ERR);
+    memcpy(base, &lib, sizeof(lib));
+    if (fread(base + sizeof(lib), 1, size - sizeof(lib), file) 
+	!= size - sizeof(lib)) {
+      free(base);
+      return (vfm_errno = VFM_FILE_ERR);
     }
+    arc->size = size;
+    arc->mapped = VFM_ARC_READ;
+  }
+  arc->base = base;
+  if (check_strings(base)) {
+    vfm_arc_close(arc);
+    return (vfm_errno = VFM_MAGIC_ERR);
+  }
+  arc->count = be32toh(lib.count);
+  arc->buckets = be32toh(lib.buckets);
+
+  return (vfm_errno = VFM_NOERR);
+}
 
-  // Opps! Not found in archive
-  return (vfm_errno = VFM_ARC_SEARCH_ERR);
+int vfm_arc_init(vfm_arc_t* arc, char* base, long size)
+{
+  if (!arc || !base) return (vfm_errno = VFM_ERR);
+
+  // Check header in memory; members are loaded in place
+  memset(arc, 0, sizeof(vfm_arc_t));
+  if (size < (long) sizeof(vfm_lib_t) || check((vfm_lib_t*) base)
+      || be32toh(((vfm_lib_t*) base)->size) > size
+      || check_strings(base))
+    return (vfm_errno = VFM_MAGIC_ERR);
+  arc->base = base;
+  arc->size = size;
+  arc->mapped = VFM_ARC_MEMORY;
+  arc->count = be32toh(((vfm_lib_t*) base)->count);
+  arc->buckets = be32toh(((vfm_lib_t*) base)->buckets);
+
+  return (vfm_errno = VFM_NOERR);
 }
 
+// NB: Close unmaps or frees the archive header and tables. Members are
+// NB: loaded in place in a mapped archive; modules loaded from it must be
+// NB: unloaded before close. An archive in memory is not released.
+
+int vfm_arc_close(vfm_arc_t* arc)
+{
+  if (!arc) return (vfm_errno = VFM_ERR);
+
+  if (arc->mapped == VFM_ARC_MAPPED && arc->base)
+    munmap(arc->base, arc->size);
+  else if (arc->mapped == VFM_ARC_READ)
+    free(arc->base);
+  memset(arc, 0, sizeof(vfm_arc_t));
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+int vfm_arc_member(vfm_arc_t* arc, int nr, vfm_map_t* map)
+{
+  if (!arc || !arc->base || !map || nr < 0 || nr >= arc->count) 
+    return (vfm_errno = VFM_ERR);
+
+  char* strings = arc->base + LIB(arc, strings);
+  char* mp = MEMBER(arc, nr);
+
+  map->name = strings + FIELD(mp, name);
+  map->ident = strings + FIELD(mp, ident);
+  map->version = strings + FIELD(mp, version);
+  map->timestamp = (time_t) FIELD(mp, timestamp);
+  map->size = FIELD(mp, size);
+  map->pos = FIELD(mp, pos);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+int vfm_arc_load(FILE* file, char* name, int debug, vfm_mod_t *mod, vfm_arc_t* arc)
+{
+  vfm_map_t map;
+  int nr;
+
+  // Check that the archive index is loaded
+  if (!arc->base && vfm_arc_map_load(file, arc))
+    return (vfm_errno);
+
+  // Lookup in name index and load object code; in place when mapped
+  nr = find(arc, name);
+  if (nr < 0) return (vfm_errno = VFM_ARC_SEARCH_ERR);
+  vfm_arc_member(arc, nr, &map);
+  if (arc->mapped != VFM_ARC_READ) {
+    if ((long) map.pos + map.size > arc->size) 
+      return (vfm_errno = VFM_MAGIC_ERR);
+    load(0, arc->base + map.pos, debug, mod, arc);
+  } else {
+    fseek(file, map.pos, SEEK_SET);
+    load(file, 0, debug, mod, arc);
+  }
+  return (vfm_errno);
+}
@@ -0,0 +1,108 @@
+# NB: Generate operation micro-benchmarks from runtime.c; source files
+# NB: (dir/ops.fpp, dir/lib.fpp) and manifest (dir/ops.bench) for
+# NB: vfbench -c. Compiled and run in dir; modules without package.
+# NB: Operation lines with a comment "word ( inputs -- outputs )" are
+# NB: benchmarked; followed by the control constructs. Each benchmark
+# NB: has an empty loop with the same inputs for subtraction. Loops
+# NB: are kept stack-neutral with empty (reset of parameter stack).
+# NB: Input names map to literals; addr to here (data area) and xt to an
+# NB: empty function. Numbers are used as is. Operations without a
+# NB: stack effect must be listed as covered by the control constructs
+# NB: (compiled code only) or as excluded (side effects); any other is
+# NB: reported and the generation fails so that new operations are not
+# NB: silently left without a benchmark.
+
+BEGIN {
+  if (count == "") count = 1000;
+  if (samples == "") samples = 21;
+  if (dir == "") dir = "opbench";
+  n = split("NEST UNNEST MEST UNMEST BRA BRZE DBZN RBNE RPUSH RPOP " \
+	    "NNEST UNNEZE MESTI UNMEZT UNSLIT UNLIT BRAX BRZX BRZN RBZN " \
+	    "RDBG RBRI RDNE RDUP LOCAL PLIT SLIT OVER_EQ_BRZE DUP_BRZE " \
+	    "LIT_STORE RPUSH_RPUSH", op, " ");
+  for (i = 1; i <= n; i++) covered[op[i]] = 1;
+  n = split("EXT0 EXT1 EXT2 EXT3 TRACING PROFILING ALLOT TRACE PROFILE " \
+	    "DUMP PUTC PUTI PUTX PUTS CR GETC GETS VERSION IDENT HALT", op, " ");
+  for (i = 1; i <= n; i++) excluded[op[i]] = 1;
+  uncovered = "";
+  source = dir "/ops.fpp";
+  library = dir "/lib.fpp";
+  manifest = dir "/ops.bench";
+  print "// Module call target generated by makefile (opbench.awk)" > library;
+  print "" > library;
+  print "module lib" > library;
+  print "  : f0 ;" > library;
+  print "endmodule" > library;
+  print "// Operation micro-benchmarks generated by makefile (opbench.awk)" > source;
+  print "" > source;
+  print "module ops" > source;
+  print "" > source;
+  print "  use lib" > source;
+  print "" > source;
+  print "  : f0 ;" > source;
+  print "  : f1 ;" > source;
+  print "  : g ( x -- x ) ;" > source;
+  print "  : g ( x -- x ) dup 0> guard ;" > source;
+  print "" > source;
+  print "# Operation micro-benchmarks generated by makefile (opbench.awk)" > manifest;
+  print "# Cost per iteration; vfbench -c " count " ops.bench" > manifest;
+}
+
+function input(effect, n, i, arg, res) {
+  sub(/^.*\(/, "", effect);
+  sub(/--.*$/, "", effect);
+  n = split(effect, arg, " ");
+  res = "";
+  for (i = 1; i <= n; i++) {
+    if (arg[i] ~ /^-?[0-9]+$/) res = res arg[i] " ";
+    else if (arg[i] == "addr") res = res "here ";
+    else if (arg[i] == "xt") res = res "' f0 ";
+    else res = res "1 ";
+  }
+  return (res);
+}
+
+function bench(name, args, body) {
+  print "  : " name " " count " for " args body " empty next ;" > source;
+  print "  : " name ".empty " count " for " args "empty next ;" > source;
+  print name " ops " name " " samples > manifest;
+  print name ".empty ops " name ".empty " samples > manifest;
+}
+
+/^OP\([A-Z0-9_]*\) \/\/ .*\(.*--.*\)/ {
+  name = $0;
+  sub(/^OP\(/, "", name);
+  sub(/\).*/, "", name);
+  word = $0;
+  sub(/^[^\/]*\/\/ /, "", word);
+  sub(/ *\(.*$/, "", word);
+  bench(name, input($0), word);
+  next;
+}
+
+/^OP\([A-Z0-9_]*\)/ {
+  name = $0;
+  sub(/^OP\(/, "", name);
+  sub(/\).*/, "", name);
+  if (!(name in covered) && !(name in excluded)) uncovered = uncovered " " name;
+}
+
+END {
+  print "" > source;
+  print "  // Control constructs" > source;
+  print "" > source;
+  bench("for-next", "", "0 for next");
+  bench("do-loop", "", "0 0 do loop");
+  bench("case-of", "2 ", "case 0 of 1 endof 1 of 2 endof 2 of 3 endof endcase");
+  bench("select-call", "1 ", "select f0 f1 endselect");
+  bench("guard-call", "0 ", "g");
+  bench("nest-call", "", "f0");
+  bench("mest-call", "", "lib::f0");
+  bench("rpush-rpop", "1 ", ">r r>");
+  print "" > source;
+  print "endmodule" > source;
+  if (uncovered != "") {
+    print "opbench.awk: error: operations without benchmark:" uncovered > "/dev/stderr";
+    exit 1;
+  }
+}
@@ -0,0 +1,33 @@
+// NB: Operation operand sizes generated by makefile
+
+static signed char opsize[VFM_OPMAX + 1] = {
+ [VFM_OP_EXT0] = 1,
+ [VFM_OP_EXT1] = 1,
+ [VFM_OP_EXT2] = 1,
+ [VFM_OP_EXT3] = 1,
+ [VFM_OP_NEST] = 2,
+ [VFM_OP_NNEST] = -1,
+ [VFM_OP_MEST] = 3,
+ [VFM_OP_MESTI] = 2,
+ [VFM_OP_UNLIT] = 4,
+ [VFM_OP_BRA] = 1,
+ [VFM_OP_BRAX] = 2,
+ [VFM_OP_BRZX] = 2,
+ [VFM_OP_BRZE] = 1,
+ [VFM_OP_BRZN] = 1,
+ [VFM_OP_DBZN] = 1,
+ [VFM_OP_RBZN] = 1,
+ [VFM_OP_RDBG] = 1,
+ [VFM_OP_RBRI] = 1,
+ [VFM_OP_RBNE] = 1,
+ [VFM_OP_RDNE] = 1,
+ [VFM_OP_LOCAL] = 2,
+ [VFM_OP_LIT] = 4,
+ [VFM_OP_CLIT] = 1,
+ [VFM_OP_PLIT] = 2,
+ [VFM_OP_SLIT] = -1,
+ [VFM_OP_OVER_EQ_BRZE] = 1,
+ [VFM_OP_DUP_BRZE] = 1,
+ [VFM_OP_CLIT_ADD] = 1,
+ [VFM_OP_LIT_STORE] = 4,
+};
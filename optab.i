@@ -0,0 +1,261 @@
+// NB: Operation names and jump table generated by makefile
+
+static char* opname[VFM_OPMAX + 1] = {
+ "EXT0", // [1]
+ "EXT1", // [1]
+ "EXT2", // [1]
+ "EXT3", // [1]
+ "NEXT", // nop ( -- )
+ "TRACING",
+ "PROFILING",
+ "NEST", // [2]
+ "NNEST", // [-1]
+ "UNNEST",
+ "UNNEZE",
+ "MEST", // [3]
+ "MESTI", // [2]
+ "UNMEST",
+ "UNMEZT",
+ "UNSLIT",
+ "UNLIT", // [4]
+ "BRA", // [1]
+ "BRAX", // [2]
+ "BRZX", // [2]
+ "BRZE", // [1]
+ "BRZN", // [1]
+ "DBZN", // [1]
+ "RBZN", // [1]
+ "RDBG", // [1]
+ "RBRI", // [1]
+ "RBNE", // [1]
+ "RDNE", // [1]
+ "TASK", // task ( -- addr )
+ "LOCAL", // [2]
+ "HERE", // here ( -- addr )
+ "ALLOT",
+ "TRACE",
+ "PROFILE",
+ "EXEC", // execute ( xt -- )
+ "CLOAD", // c@ ( addr -- c )
+ "CSTORE", // c! ( c addr -- )
+ "LOAD", // @ ( addr -- x )
+ "STORE", // ! ( x addr -- )
+ "ICLOAD", // +c@ ( 0 addr -- c )
+ "ICSTORE", // +c! ( c addr -- )
+ "ILOAD", // +@ ( 0 addr -- x )
+ "ISTORE", // +! ( x addr -- )
+ "RPUSH",
+ "RDUP",
+ "RPOP",
+ "RCOPY", // i ( -- x )
+ "LIT", // 1000 ( -- x ) [4]
+ "CLIT", // 100 ( -- x ) [1]
+ "PLIT", // [2]
+ "SLIT", // [-1]
+ "DEPTH", // depth ( -- n )
+ "DROP", // drop ( x -- )
+ "NIP", // nip ( x y -- y )
+ "EMPTY", // empty ( -- )
+ "DUP", // dup ( x -- x x )
+ "DUPNZ", // ?dup ( x -- x x )
+ "OVER", // over ( x y -- x y x )
+ "TUCK", // tuck ( x y -- y x y )
+ "PICK", // pick ( x y 1 -- x y x )
+ "SWAP", // swap ( x y -- y x )
+ "ROT", // rot ( x y z -- y z x )
+ "TOR", // -rot ( x y z -- z x y )
+ "ROLL", // roll ( x y 1 -- y x )
+ "CELL", // cell ( -- n )
+ "CONSTN2", // -2 ( -- n )
+ "CONSTN1", // -1 ( -- n )
+ "CONST0", // 0 ( -- n )
+ "CONST1", // 1 ( -- n )
+ "CONST2", // 2 ( -- n )
+ "CONST3", // 3 ( -- n )
+ "TRUE", // true ( -- flag )
+ "FALSE", // false ( -- flag )
+ "NOT", // not ( x -- y )
+ "AND", // and ( x y -- z )
+ "OR", // or ( x y -- z )
+ "XOR", // xor ( x y -- z )
+ "NEG", // negate ( x -- y )
+ "INC", // 1+ ( x -- y )
+ "DEC", // 1- ( x -- y )
+ "INC2", // 2+ ( x -- y )
+ "DEC2", // 2- ( x -- y )
+ "MUL2", // 2* ( x -- y )
+ "DIV2", // 2/ ( x -- y )
+ "ADD", // + ( x y -- z )
+ "SUB", // - ( x y -- z )
+ "MUL", // * ( x y -- z )
+ "MULDIV", // */ ( x y z -- w )
+ "DIV", // / ( x y -- z )
+ "REM", // % ( x y -- z )
+ "DIVREM", // /% ( x y -- z w )
+ "LSH", // << ( x n -- y )
+ "RSH", // >> ( x n -- y )
+ "ZNE", // 0<> ( x -- flag )
+ "ZLT", // 0< ( x -- flag )
+ "ZLE", // 0<= ( x -- flag )
+ "ZEQ", // 0= ( x -- flag )
+ "ZGE", // 0>= ( x -- flag )
+ "ZGT", // 0> ( x -- flag )
+ "NE", // != ( x y -- flag )
+ "LT", // < ( x y -- flag )
+ "LE", // <= ( x y -- flag )
+ "EQ", // == ( x y -- flag )
+ "GE", // >= ( x y -- flag )
+ "GT", // > ( x y -- flag )
+ "WITHIN", // within ( x lo hi -- flag )
+ "ABS", // abs ( x -- y )
+ "MIN", // min ( x y -- z )
+ "MAX", // max ( x y -- z )
+ "DUMP",
+ "PUTC",
+ "PUTI",
+ "PUTX",
+ "PUTS",
+ "CR",
+ "GETC",
+ "GETS",
+ "VERSION",
+ "IDENT",
+ "HALT",
+ "OVER_EQ_BRZE", // [1]
+ "DUP_BRZE", // [1]
+ "CLIT_ADD", // 100 + ( x -- y ) [1]
+ "LIT_STORE", // [4]
+ "RPUSH_RPUSH",
+ "RCOPY_ADD", // i + ( x -- y )
+ 0
+};
+
+static void* optab[VFM_OPMAX + 1] = {
+ &&EXT0, // [1]
+ &&EXT1, // [1]
+ &&EXT2, // [1]
+ &&EXT3, // [1]
+ &&NEXT, // nop ( -- )
+ &&TRACING,
+ &&PROFILING,
+ &&NEST, // [2]
+ &&NNEST, // [-1]
+ &&UNNEST,
+ &&UNNEZE,
+ &&MEST, // [3]
+ &&MESTI, // [2]
+ &&UNMEST,
+ &&UNMEZT,
+ &&UNSLIT,
+ &&UNLIT, // [4]
+ &&BRA, // [1]
+ &&BRAX, // [2]
+ &&BRZX, // [2]
+ &&BRZE, // [1]
+ &&BRZN, // [1]
+ &&DBZN, // [1]
+ &&RBZN, // [1]
+ &&RDBG, // [1]
+ &&RBRI, // [1]
+ &&RBNE, // [1]
+ &&RDNE, // [1]
+ &&TASK, // task ( -- addr )
+ &&LOCAL, // [2]
+ &&HERE, // here ( -- addr )
+ &&ALLOT,
+ &&TRACE,
+ &&PROFILE,
+ &&EXEC, // execute ( xt -- )
+ &&CLOAD, // c@ ( addr -- c )
+ &&CSTORE, // c! ( c addr -- )
+ &&LOAD, // @ ( addr -- x )
+ &&STORE, // ! ( x addr -- )
+ &&ICLOAD, // +c@ ( 0 addr -- c )
+ &&ICSTORE, // +c! ( c addr -- )
+ &&ILOAD, // +@ ( 0 addr -- x )
+ &&ISTORE, // +! ( x addr -- )
+ &&RPUSH,
+ &&RDUP,
+ &&RPOP,
+ &&RCOPY, // i ( -- x )
+ &&LIT, // 1000 ( -- x ) [4]
+ &&CLIT, // 100 ( -- x ) [1]
+ &&PLIT, // [2]
+ &&SLIT, // [-1]
+ &&DEPTH, // depth ( -- n )
+ &&DROP, // drop ( x -- )
+ &&NIP, // nip ( x y -- y )
+ &&EMPTY, // empty ( -- )
+ &&DUP, // dup ( x -- x x )
+ &&DUPNZ, // ?dup ( x -- x x )
+ &&OVER, // over ( x y -- x y x )
+ &&TUCK, // tuck ( x y -- y x y )
+ &&PICK, // pick ( x y 1 -- x y x )
+ &&SWAP, // swap ( x y -- y x )
+ &&ROT, // rot ( x y z -- y z x )
+ &&TOR, // -rot ( x y z -- z x y )
+ &&ROLL, // roll ( x y 1 -- y x )
+ &&CELL, // cell ( -- n )
+ &&CONSTN2, // -2 ( -- n )
+ &&CONSTN1, // -1 ( -- n )
+ &&CONST0, // 0 ( -- n )
+ &&CONST1, // 1 ( -- n )
+ &&CONST2, // 2 ( -- n )
+ &&CONST3, // 3 ( -- n )
+ &&TRUE, // true ( -- flag )
+ &&FALSE, // false ( -- flag )
+ &&NOT, // not ( x -- y )
+ &&AND, // and ( x y -- z )
+ &&OR, // or ( x y -- z )
+ &&XOR, // xor ( x y -- z )
+ &&NEG, // negate ( x -- y )
+ &&INC, // 1+ ( x -- y )
+ &&DEC, // 1- ( x -- y )
+ &&INC2, // 2+ ( x -- y )
+ &&DEC2, // 2- ( x -- y )
+ &&MUL2, // 2* ( x -- y )
+ &&DIV2, // 2/ ( x -- y )
+ &&ADD, // + ( x y -- z )
+ &&SUB, // - ( x y -- z )
+ &&MUL, // * ( x y -- z )
+ &&MULDIV, // */ ( x y z -- w )
+ &&DIV, // / ( x y -- z )
+ &&REM, // % ( x y -- z )
+ &&DIVREM, // /% ( x y -- z w )
+ &&LSH, // << ( x n -- y )
+ &&RSH, // >> ( x n -- y )
+ &&ZNE, // 0<> ( x -- flag )
+ &&ZLT, // 0< ( x -- flag )
+ &&ZLE, // 0<= ( x -- flag )
+ &&ZEQ, // 0= ( x -- flag )
+ &&ZGE, // 0>= ( x -- flag )
+ &&ZGT, // 0> ( x -- flag )
+ &&NE, // != ( x y -- flag )
+ &&LT, // < ( x y -- flag )
+ &&LE, // <= ( x y -- flag )
+ &&EQ, // == ( x y -- flag )
+ &&GE, // >= ( x y -- flag )
+ &&GT, // > ( x y -- flag )
+ &&WITHIN, // within ( x lo hi -- flag )
+ &&ABS, // abs ( x -- y )
+ &&MIN, // min ( x y -- z )
+ &&MAX, // max ( x y -- z )
+ &&DUMP,
+ &&PUTC,
+ &&PUTI,
+ &&PUTX,
+ &&PUTS,
+ &&CR,
+ &&GETC,
+ &&GETS,
+ &&VERSION,
+ &&IDENT,
+ &&HALT,
+ &&OVER_EQ_BRZE, // [1]
+ &&DUP_BRZE, // [1]
+ &&CLIT_ADD, // 100 + ( x -- y ) [1]
+ &&LIT_STORE, // [4]
+ &&RPUSH_RPUSH,
+ &&RCOPY_ADD, // i + ( x -- y )
+ 0
+};
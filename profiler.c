@@ -15,6 +15,9 @@
    along with vfm.  If not, see <http://www.gnu.org/licenses/>. */
 
 #include "vfm.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
 
 int vfm_profile(FILE* file, vfm_mod_t *mod)
 { 
@@ -31,7 +34,7 @@ int vfm_profile(FILE* file, vfm_mod_t *mod)
   if (mod->dict.symbols) {
     for (i = 0; i < mod->dict.count; i++)
       if (mod->dict.symbols[i].refcnt) {
-	fprintf(file, "%8d %s::%s\n", 
+	fprintf(file, "%8lld %s::%s\n", 
 		mod->dict.symbols[i].refcnt,
 		mod->name, 
 		mod->dict.symbols[i].name);
@@ -44,7 +47,7 @@ int vfm_profile(FILE* file, vfm_mod_t *mod)
     if (use->dict.symbols) {
       for (j = 0; j < use->dict.count; j++)
 	if (use->dict.symbols[j].refcnt) {
-	  fprintf(file, "%8d %s::%s\n", 
+	  fprintf(file, "%8lld %s::%s\n", 
 		  use->dict.symbols[j].refcnt,
 		  use->name, 
 		  use->dict.symbols[j].name);
@@ -53,9 +56,9 @@ int vfm_profile(FILE* file, vfm_mod_t *mod)
   }
 
   // Write non-zero profile values for kernel operations
-  for (i = 0; i <= VFM_OP_HALT; i++)
+  for (i = 0; i <= VFM_OP_LAST; i++)
     if (vfm_oprefcnt[i]) {
-      fprintf(file, "%8d vfm::%s\n", vfm_oprefcnt[i], vfm_opname[i]);
+      fprintf(file, "%8lld vfm::%s\n", vfm_oprefcnt[i], vfm_opname[i]);
     }
 
   return (vfm_errno = VFM_NOERR);
@@ -69,12 +72,14 @@ int vfm_coverage(FILE* file, vfm_mod_t *mod)
 
   // Write coverage: module, used, kernel
   vfm_mod_t* use;
-  int total;
+  long long total;
   int count;
   int i;
   int j;
 
-  // Collect statistics for symbols in module and write coverage
+  // Collect statistics for symbols in module and write coverage.
+  // Symbols not loaded (on demand) are loaded for the totals
+  if (VFM_PENDING(&mod->dict)) vfm_load_symbols(mod);
   if (mod->dict.symbols) {
     total = 0;
     count = 0;
@@ -83,7 +88,7 @@ int vfm_coverage(FILE* file, vfm_mod_t *mod)
 	total += mod->dict.symbols[i].refcnt;
 	count += 1;
       }
-    fprintf(file, "%8d %s %d/%d (%d%%)\n",
+    fprintf(file, "%8lld %s %d/%d (%d%%)\n",
 	    total, mod->name, count, mod->dict.count,
 	    count * 100 / mod->dict.count);
   }
@@ -91,6 +96,7 @@ int vfm_coverage(FILE* file, vfm_mod_t *mod)
   // Collect statistics for symbols in used modules and write coverage
   for (i = 0; i < mod->use.count; i++) {
     use = mod->use.mod[i];
+    if (VFM_PENDING(&use->dict)) vfm_load_symbols(use);
     if (use->dict.symbols) {
       total = 0;
       count = 0;
@@ -99,7 +105,7 @@ int vfm_coverage(FILE* file, vfm_mod_t *mod)
 	  total += use->dict.symbols[j].refcnt;
 	  count += 1;
 	}
-      fprintf(file, "%8d %s %d/%d (%d%%)\n",
+      fprintf(file, "%8lld %s %d/%d (%d%%)\n",
 	      total, use->name, count, use->dict.count,
 	      count * 100 / use->dict.count);
     }
@@ -108,13 +114,13 @@ int vfm_coverage(FILE* file, vfm_mod_t *mod)
   // Collect statistics for symbols in kernel and write coverage
   count = 0;
   total = 0;
-  for (i = 0; i <= VFM_OP_HALT; i++)
+  for (i = 0; i <= VFM_OP_LAST; i++)
     if (vfm_oprefcnt[i]) {
       total += vfm_oprefcnt[i];
       count += 1;
     }
-  fprintf(file, "%8d vfm %d/%d (%d%%)\n", 
-	  total, count, VFM_OP_HALT, count * 100 / VFM_OP_HALT);
+  fprintf(file, "%8lld vfm %d/%d (%d%%)\n", 
+	  total, count, VFM_OP_LAST, count * 100 / VFM_OP_LAST);
 
   return (vfm_errno = VFM_NOERR);
 }
@@ -127,24 +133,563 @@ int vfm_reset_counters(vfm_mod_t *mod)
   // Reset all counters
   vfm_mod_t* use;
   int i;
+  int j;
 
-  // Reset counters for symbols in module
+  // Reset counters for symbols and instructions in module
   if (mod->dict.symbols)
     for (i = 0; i < mod->dict.count; i++)
       mod->dict.symbols[i].refcnt = 0;
+  if (mod->segment.refcnt)
+    for (i = 0; i < mod->segment.size; i++)
+      mod->segment.refcnt[i] = 0;
 
-  // Reset counters for symbols in used modules
+  // Reset counters for symbols and instructions in used modules
   for (i = 0; i < mod->use.count; i++) {
     use = mod->use.mod[i];
     if (use->dict.symbols) {
-      for (i = 0; i < use->dict.count; i++)
-	use->dict.symbols[i].refcnt = 0;
+      for (j = 0; j < use->dict.count; j++)
+	use->dict.symbols[j].refcnt = 0;
+    }
+    if (use->segment.refcnt) {
+      for (j = 0; j < use->segment.size; j++)
+	use->segment.refcnt[j] = 0;
     }
   }
 
-  // Reset counters for kernel operations
-  for (i = 0; i <= VFM_OP_HALT; i++)
+  // Reset counters for kernel operations and operation sequences
+  for (i = 0; i <= VFM_OP_LAST; i++)
     vfm_oprefcnt[i] = 0;
+  vfm_ngram_reset();
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+// NB: Instruction counters (segment.refcnt) are allocated when a module
+// NB: is first profiled or a profile is merged; freed on unload (loader.c)
+
+long long* vfm_counters(vfm_mod_t *mod)
+{
+  long long* refcnt = mod->segment.refcnt;
+
+  if (refcnt || mod->segment.size <= 0) return (refcnt);
+  refcnt = (long long*) calloc(mod->segment.size, sizeof(long long));
+  if (!refcnt) return (0);
+  if (!__sync_bool_compare_and_swap(&mod->segment.refcnt, 0, refcnt))
+    free(refcnt);
+  return (mod->segment.refcnt);
+}
+
+// NB: Source line counters are collected from the instruction counters
+// NB: (segment.refcnt) in the range of the line table entry
+
+static long long line_refcnt(vfm_mod_t* mod, int i, long long* max)
+{
+  int start = mod->ltab.lines[i].offset;
+  int end = ((i + 1) < mod->ltab.count ? 
+	     mod->ltab.lines[i + 1].offset : 
+	     mod->segment.size);
+  long long total = 0;
+
+  *max = 0;
+  if (!mod->segment.refcnt) return (0);
+  for (; start < end; start++) {
+    total += mod->segment.refcnt[start];
+    if (mod->segment.refcnt[start] > *max)
+      *max = mod->segment.refcnt[start];
+  }
+  return (total);
+}
+
+static void line_profile(FILE* file, vfm_mod_t *mod)
+{
+  long long total;
+  long long max;
+  int i;
+
+  if (!mod->segment.refcnt) return;
+  for (i = 0; i < mod->ltab.count; i++) {
+    total = line_refcnt(mod, i, &max);
+    if (total) {
+      fprintf(file, "%8lld %s:%d\n", total, 
+	      mod->ltab.file, mod->ltab.lines[i].line);
+    }
+  }
+}
+
+int vfm_line_profile(FILE* file, vfm_mod_t *mod)
+{
+  // Basic parameter check
+  if (!file) return (VFM_FILE_ERR);
+  if (!mod) return (VFM_ERR);
+
+  int i;
+
+  // Write non-zero number of dispatched instructions per source line
+  line_profile(file, mod);
+  for (i = 0; i < mod->use.count; i++)
+    line_profile(file, mod->use.mod[i]);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+static void lcov(FILE* file, vfm_mod_t *mod)
+{
+  vfm_symb_t* symb;
+  vfm_line_t* line;
+  long long max;
+  int count;
+  int i;
+
+  if (VFM_PENDING(&mod->dict)) vfm_load_symbols(mod);
+  if (!mod->ltab.count) return;
+  fprintf(file, "TN:\nSF:%s\n", mod->ltab.file);
+
+  // Write function coverage; line number, name and number of calls
+  symb = mod->dict.symbols;
+  for (i = 0; i < mod->dict.count; i++) {
+    line = vfm_addr2line(symb[i].code, mod);
+    if (line) fprintf(file, "FN:%d,%s\n", line->line, symb[i].name);
+  }
+  for (count = 0, i = 0; i < mod->dict.count; i++) {
+    fprintf(file, "FNDA:%lld,%s\n", symb[i].refcnt, symb[i].name);
+    if (symb[i].refcnt) count += 1;
+  }
+  fprintf(file, "FNF:%d\nFNH:%d\n", mod->dict.count, count);
+
+  // Write line coverage; line number and number of executions
+  for (count = 0, i = 0; i < mod->ltab.count; i++) {
+    line_refcnt(mod, i, &max);
+    fprintf(file, "DA:%d,%lld\n", mod->ltab.lines[i].line, max);
+    if (max) count += 1;
+  }
+  fprintf(file, "LF:%d\nLH:%d\n", mod->ltab.count, count);
+  fprintf(file, "end_of_record\n");
+}
+
+int vfm_lcov(FILE* file, vfm_mod_t *mod)
+{
+  // Basic parameter check
+  if (!file) return (VFM_FILE_ERR);
+  if (!mod) return (VFM_ERR);
+
+  int i;
+
+  // Write coverage in lcov tracefile format for modules with line tables
+  lcov(file, mod);
+  for (i = 0; i < mod->use.count; i++)
+    lcov(file, mod->use.mod[i]);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+// NB: Binary profile format; magic, time and module count followed by
+// NB: module name, timestamp and records [name, offset, refcnt] with
+// NB: non-zero symbol (name) and instruction (empty name) counters.
+// NB: Kernel operations are stored as module vfm with opcode as offset.
+// NB: Counters are 64-bit (fputlong) so that merged profiles do not wrap.
+
+static int profile_records(vfm_mod_t *mod)
+{
+  int count = 0;
+  int i;
+
+  if (mod->dict.symbols)
+    for (i = 0; i < mod->dict.count; i++)
+      if (mod->dict.symbols[i].refcnt) count += 1;
+  if (mod->segment.refcnt)
+    for (i = 0; i < mod->segment.size; i++)
+      if (mod->segment.refcnt[i]) count += 1;
+  return (count);
+}
+
+static void profile_store(FILE* file, vfm_mod_t *mod)
+{
+  vfm_symb_t* symb = mod->dict.symbols;
+  int i;
+
+  fputstr(mod->name, file);
+  fputint((int) mod->timestamp, file);
+  fputint(profile_records(mod), file);
+  if (symb)
+    for (i = 0; i < mod->dict.count; i++)
+      if (symb[i].refcnt) {
+	fputstr(symb[i].name, file);
+	fputint(symb[i].code - mod->segment.code, file);
+	fputlong(symb[i].refcnt, file);
+      }
+  if (mod->segment.refcnt)
+    for (i = 0; i < mod->segment.size; i++)
+      if (mod->segment.refcnt[i]) {
+	fputstr("", file);
+	fputint(i, file);
+	fputlong(mod->segment.refcnt[i], file);
+      }
+}
+
+int vfm_profile_store(FILE* file, vfm_mod_t *mod)
+{
+  // Basic parameter check
+  if (!file) return (VFM_FILE_ERR);
+  if (!mod) return (VFM_ERR);
+
+  int count;
+  int i;
+
+  // Write header; magic, time and number of modules (with kernel)
+  fputs(VFM_PROF_MAGIC, file);
+  fputint((int) time(NULL), file);
+  fputint(mod->use.count + 2, file);
+
+  // Write module and used modules counters
+  profile_store(file, mod);
+  for (i = 0; i < mod->use.count; i++)
+    profile_store(file, mod->use.mod[i]);
+
+  // Write kernel operation counters
+  for (count = 0, i = 0; i <= VFM_OP_LAST; i++)
+    if (vfm_oprefcnt[i]) count += 1;
+  fputstr("vfm", file);
+  fputint(0, file);
+  fputint(count, file);
+  for (i = 0; i <= VFM_OP_LAST; i++)
+    if (vfm_oprefcnt[i]) {
+      fputstr(vfm_opname[i], file);
+      fputint(i, file);
+      fputlong(vfm_oprefcnt[i], file);
+    }
+
+  return (vfm_errno = ferror(file) ? VFM_FILE_ERR : VFM_NOERR);
+}
+
+static vfm_mod_t* profile_module(char* name, int timestamp, vfm_mod_t *mod)
+{
+  int i;
+
+  if (!strcmp(name, mod->name))
+    return (mod->timestamp == timestamp ? mod : 0);
+  for (i = 0; i < mod->use.count; i++)
+    if (!strcmp(name, mod->use.mod[i]->name))
+      return (mod->use.mod[i]->timestamp == timestamp ? mod->use.mod[i] : 0);
+  return (0);
+}
+
+int vfm_profile_load(FILE* file, vfm_mod_t *mod)
+{
+  // Basic parameter check
+  if (!file) return (VFM_FILE_ERR);
+  if (!mod) return (VFM_ERR);
+
+  char name[256];
+  vfm_symb_t* symb;
+  vfm_mod_t* mp;
+  int timestamp;
+  int modules;
+  int records;
+  long long refcnt;
+  int offset;
+  int kernel;
+  int i;
+  int j;
+
+  // Read header; magic, time and number of modules
+  if (!fgets(name, sizeof(name), file) || strcmp(name, VFM_PROF_MAGIC))
+    return (vfm_errno = VFM_MAGIC_ERR);
+  fgetint(&timestamp, file);
+  fgetint(&modules, file);
+
+  // Add counters to matching modules; other modules are skipped
+  for (i = 0; i < modules; i++) {
+    fgetstr(name, file);
+    fgetint(&timestamp, file);
+    fgetint(&records, file);
+    kernel = !strcmp(name, "vfm");
+    mp = profile_module(name, timestamp, mod);
+    for (j = 0; j < records; j++) {
+      fgetstr(name, file);
+      fgetint(&offset, file);
+      if (fgetlong(&refcnt, file) != 1) return (vfm_errno = VFM_FILE_ERR);
+      if (kernel) {
+	if (offset >= 0 && offset <= VFM_OP_LAST) 
+	  vfm_oprefcnt[offset] += refcnt;
+      } else if (mp && *name) {
+	symb = vfm_name2symb(name, &mp->dict);
+	if (symb) symb->refcnt += refcnt;
+      } else if (mp && vfm_counters(mp)) {
+	if (offset >= 0 && offset < mp->segment.size)
+	  mp->segment.refcnt[offset] += refcnt;
+      }
+    }
+  }
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+// NB: Live metrics are written in Prometheus text exposition format.
+// NB: Dispatches are only counted by the instrumented engine; the total
+// NB: and rate (from the previous snapshot) are written when profiling.
+// NB: Stack high-water marks are written when the stacks are poisoned;
+// NB: heap usage is the allocation pointer (not poisoned).
+
+char* vfm_metrics_file = 0;
+
+static void metrics_symbols(FILE* file, vfm_mod_t *mod)
+{
+  int i;
+
+  if (!mod->dict.symbols) return;
+  for (i = 0; i < mod->dict.count; i++)
+    if (mod->dict.symbols[i].refcnt)
+      fprintf(file, "vfm_symbol_calls_total{module=\"%s\",symbol=\"%s\"} %lld\n",
+	      mod->name, mod->dict.symbols[i].name,
+	      mod->dict.symbols[i].refcnt);
+}
+
+int vfm_metrics(FILE* file, vfm_env_t *env)
+{
+  // Basic parameter check
+  if (!file) return (VFM_FILE_ERR);
+  if (!env) return (VFM_ERR);
+
+  static long long last_total = 0;
+  static double last_time = 0.0;
+  struct timeval tv;
+  long long total = 0;
+  double now;
+  vfm_mod_t* mod = env->mp;
+  int data;
+  int ret;
+  int i;
+
+  // Sum kernel operation dispatches and calculate rate
+  gettimeofday(&tv, NULL);
+  now = tv.tv_sec + tv.tv_usec / 1000000.0;
+  for (i = 0; i <= VFM_OP_LAST; i++)
+    total += vfm_oprefcnt[i];
+  if (total < last_total) last_total = 0;
+
+  // Write environment gauges
+  fprintf(file, "# TYPE vfm_tasks gauge\n");
+  fprintf(file, "vfm_tasks %d\n", vfm_tasks);
+  fprintf(file, "# TYPE vfm_profiling gauge\n");
+  fprintf(file, "vfm_profiling %d\n",
+	  (env->status & VFM_PROFILING_STATUS) != 0);
+  fprintf(file, "# TYPE vfm_data_stack_depth gauge\n");
+  fprintf(file, "vfm_data_stack_depth %d\n", 
+	  (int) (env->sp > env->sp0 ? env->sp - env->sp0 - 1 : 0));
+  fprintf(file, "# TYPE vfm_return_stack_depth gauge\n");
+  fprintf(file, "vfm_return_stack_depth %d\n", 
+	  (int) (env->rp < env->rp0 ? 0 : env->rp - env->rp0));
+  fprintf(file, "# TYPE vfm_heap_used_bytes gauge\n");
+  fprintf(file, "vfm_heap_used_bytes %d\n",
+	  (int) ((char*) env->dp - (char*) env->dp0));
+  if (!vfm_high_water(env, &data, &ret, 0)) {
+    fprintf(file, "# TYPE vfm_data_stack_high_water gauge\n");
+    fprintf(file, "vfm_data_stack_high_water %d\n", data);
+    fprintf(file, "# TYPE vfm_return_stack_high_water gauge\n");
+    fprintf(file, "vfm_return_stack_high_water %d\n", ret);
+  }
+
+  // Write dispatch counters and rate when profiling
+  if (env->status & VFM_PROFILING_STATUS) {
+    fprintf(file, "# TYPE vfm_dispatches_total counter\n");
+    fprintf(file, "vfm_dispatches_total %lld\n", total);
+    fprintf(file, "# TYPE vfm_dispatch_rate gauge\n");
+    fprintf(file, "vfm_dispatch_rate %.1f\n",
+	    (last_time > 0.0 && now > last_time) ?
+	    (double) (total - last_total) / (now - last_time) : 0.0);
+    last_total = total;
+    last_time = now;
+  } else {
+    last_time = 0.0;
+  }
+
+  // Write kernel operation counters
+  fprintf(file, "# TYPE vfm_op_dispatches_total counter\n");
+  for (i = 0; i <= VFM_OP_LAST; i++)
+    if (vfm_oprefcnt[i])
+      fprintf(file, "vfm_op_dispatches_total{op=\"%s\"} %lld\n",
+	      vfm_opname[i], vfm_oprefcnt[i]);
+
+  // Write symbol counters for module and used modules
+  if (mod) {
+    fprintf(file, "# TYPE vfm_symbol_calls_total counter\n");
+    metrics_symbols(file, mod);
+    for (i = 0; i < mod->use.count; i++)
+      metrics_symbols(file, mod->use.mod[i]);
+  }
+
+  return (vfm_errno = ferror(file) ? VFM_FILE_ERR : VFM_NOERR);
+}
+
+int vfm_snapshot(vfm_env_t *env)
+{
+  // Basic parameter check
+  if (!vfm_metrics_file) return (VFM_FILE_ERR);
+  if (!env) return (VFM_ERR);
+
+  char tmpname[FILENAME_MAX];
+  FILE* file;
+
+  // Write metrics to temporary file and replace atomically
+  snprintf(tmpname, sizeof(tmpname), "%s.tmp", vfm_metrics_file);
+  file = fopen(tmpname, "w");
+  if (!file) return (vfm_errno = VFM_FILE_ERR);
+  vfm_metrics(file, env);
+  if (fclose(file) || vfm_errno) {
+    remove(tmpname);
+    return (vfm_errno = VFM_FILE_ERR);
+  }
+  if (rename(tmpname, vfm_metrics_file)) return (vfm_errno = VFM_FILE_ERR);
+  return (vfm_errno = VFM_NOERR);
+}
+
+// NB: Operation sequences (n-grams) are counted in a hashed table.
+// NB: The key packs the sequence kind and three 10-bit operation codes.
+// NB: NEST and MEST are part of the sequence; the pair of operations
+// NB: on each side of a call is counted as a call boundary sequence.
+// NB: Returns (UNNEST, UNMEST) end the window so that sequences do not
+// NB: run across word exits; the pair around the return is a boundary.
+// NB: Boundary sequences are listed with the call or return operation
+// NB: before the bar, e.g. "a NEST | op" and "a UNNEST | op".
+
+#define NGRAM_MAX 4096
+#define NGRAM_BOUNDARY 1
+#define NGRAM_BIGRAM 2
+#define NGRAM_TRIGRAM 3
+
+#define ngram_exit(op) \
+  ((op) == VFM_OP_UNNEST || (op) == VFM_OP_UNMEST || (op) == VFM_OP_UNMEZT)
+
+#define ngram_key(kind,a,b,c) \
+  (((unsigned) (kind) << 30) | ((a) << 20) | ((b) << 10) | (c))
+
+typedef struct ngram_t {
+  unsigned key;
+  long long refcnt;
+} ngram_t;
+
+static ngram_t ngram[NGRAM_MAX];
+static int ngram_hist[2];
+static int ngram_depth = 0;
+static long long ngram_total = 0;
+static long long ngram_lost = 0;
+
+static void ngram_inc(unsigned key)
+{
+  unsigned i = (key * 2654435761U) % NGRAM_MAX;
+  int n;
+
+  // Linear probing; count sequences that do not fit as lost
+  for (n = 0; n < NGRAM_MAX; n++, i = (i + 1) % NGRAM_MAX) {
+    if (ngram[i].key == key) {
+      ngram[i].refcnt += 1;
+      return;
+    }
+    if (ngram[i].key == 0) {
+      ngram[i].key = key;
+      ngram[i].refcnt = 1;
+      return;
+    }
+  }
+  ngram_lost += 1;
+}
+
+void vfm_ngram_count(int op)
+{
+  int a = ngram_hist[0];
+  int b = ngram_hist[1];
+
+  // Count boundary sequence over a return; the window was reset
+  ngram_total += 1;
+  if (ngram_depth == 0 && ngram_exit(b))
+    ngram_inc(ngram_key(NGRAM_BOUNDARY, a, b, op));
+
+  // Count bigram and trigram ending with operation
+  if (ngram_depth > 0) 
+    ngram_inc(ngram_key(NGRAM_BIGRAM, 0, b, op));
+  if (ngram_depth > 1) {
+    ngram_inc(ngram_key(NGRAM_TRIGRAM, a, b, op));
+    if (b == VFM_OP_NEST || b == VFM_OP_MEST)
+      ngram_inc(ngram_key(NGRAM_BOUNDARY, a, b, op));
+  }
+
+  // Shift operation into history
+  ngram_hist[0] = b;
+  ngram_hist[1] = op;
+  if (ngram_exit(op))
+    ngram_depth = 0;
+  else if (ngram_depth < 2)
+    ngram_depth += 1;
+}
+
+static int ngram_cmp(const void* x, const void* y)
+{
+  long long a = ((ngram_t*) x)->refcnt;
+  long long b = ((ngram_t*) y)->refcnt;
+  return ((a < b) - (a > b));
+}
+
+int vfm_ngram_profile(FILE* file, int max)
+{
+  // Basic parameter check
+  if (!file) return (VFM_FILE_ERR);
+  if (ngram_total == 0) return (vfm_errno = VFM_NOERR);
+
+  ngram_t* top;
+  unsigned key;
+  int kind;
+  int count;
+  int n;
+  int i;
+
+  // Collect and sort the non-zero sequence counters
+  top = (ngram_t*) malloc(sizeof(ngram_t) * NGRAM_MAX);
+  if (!top) return (vfm_errno = VFM_MALLOC_ERR);
+  for (count = 0, i = 0; i < NGRAM_MAX; i++)
+    if (ngram[i].key) top[count++] = ngram[i];
+  qsort(top, count, sizeof(ngram_t), ngram_cmp);
+
+  // Write the most frequent sequences per kind with share of dispatches
+  for (kind = NGRAM_TRIGRAM; kind >= NGRAM_BOUNDARY; kind--) {
+    for (n = 0, i = 0; i < count && n < max; i++) {
+      key = top[i].key;
+      if ((key >> 30) != kind) continue;
+      fprintf(file, "%8lld %5.1f%% ", 
+	      top[i].refcnt, top[i].refcnt * 100.0 / ngram_total);
+      if (kind == NGRAM_TRIGRAM)
+	fprintf(file, "%s ", vfm_opname[(key >> 20) & 0x3ff]);
+      if (kind == NGRAM_BOUNDARY)
+	fprintf(file, "%s %s | %s\n", 
+		vfm_opname[(key >> 20) & 0x3ff], 
+		vfm_opname[(key >> 10) & 0x3ff], 
+		vfm_opname[key & 0x3ff]);
+      else
+	fprintf(file, "%s %s\n",
+		vfm_opname[(key >> 10) & 0x3ff], vfm_opname[key & 0x3ff]);
+      n += 1;
+    }
+  }
+  fprintf(file, "%8lld dispatches\n", ngram_total);
+  if (ngram_lost)
+    fprintf(file, "%8lld sequences lost (table full)\n", ngram_lost);
+  free(top);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+int vfm_ngram_reset()
+{
+  int i;
+
+  for (i = 0; i < NGRAM_MAX; i++) {
+    ngram[i].key = 0;
+    ngram[i].refcnt = 0;
+  }
+  ngram_hist[0] = 0;
+  ngram_hist[1] = 0;
+  ngram_depth = 0;
+  ngram_total = 0;
+  ngram_lost = 0;
 
   return (vfm_errno = VFM_NOERR);
 }
@@ -17,6 +17,18 @@
 #include "vfm.h"
 #include <string.h>
 
+// NB: The inner interpreter is compiled twice (makefile); a fast engine
+// NB: with inline next and an instrumented engine with pointer to next
+// NB: for tracing and profiling. The engines switch on status change.
+
+#if defined(VFM_INSTRUMENTED_ENGINE)
+# define VFM_USE_NEXT_POINTER
+# define VFM_RUN vfm_run_instrumented
+#else
+# define VFM_USE_INLINE_NEXT
+# define VFM_RUN vfm_run_fast
+#endif
+
 #if defined(VFM_USE_NEXT_POINTER)
 # define NEXT() goto *np
 #elif defined(VFM_USE_INLINE_NEXT)
@@ -25,14 +37,27 @@
 # define NEXT() goto NEXT
 #endif
 
-// NB: Assembly list operation hint
+// NB: External requests are polled on backward branches (negative
+// NB: offset) so that loops without calls are also interrupted
+
+#define POLL(offset) if ((offset) < 0 && vfm_request) goto REQUEST
+
+// NB: Assembly list operation hint. The comment on an operation line
+// NB: is the source word and stack effect; used to generate the
+// NB: operation micro-benchmarks (opbench.awk). A trailing [n] is the
+// NB: number of inline operand bytes, [-1] when variable length; used
+// NB: to generate the operand size table (opsize.i, vfm_opsize).
 
 #define OP(n) n: asm("# OP(" # n ")"); 
 
-int vfm_errno = 0;
+#if !defined(VFM_INSTRUMENTED_ENGINE)
+__thread int vfm_errno = 0;
 void* vfm_optab = 0;
 char** vfm_opname = 0;
-int vfm_oprefcnt[VFM_OPMAX + 1] = { 0 };
+long long vfm_oprefcnt[VFM_OPMAX + 1] = { 0 };
+volatile int vfm_request = 0;
+volatile int vfm_tasks = 0;
+#endif
 
 // Utility functions
 
@@ -45,6 +70,14 @@ static vfm_symb_t* inc_refcnt(vfm_code_t *cp, vfm_dict_t* dict)
   return (symb);
 }
 
+static void inc_opcnt(vfm_code_t *cp, vfm_mod_t* mp)
+{
+  unsigned offset = cp - mp->segment.code;
+  long long* refcnt = (mp->segment.refcnt ? mp->segment.refcnt : vfm_counters(mp));
+  if (refcnt && offset < (unsigned) mp->segment.size)
+    refcnt[offset] += 1;
+}
+
 static void ftrace(FILE* file, int depth, vfm_code_t* cp, vfm_mod_t* mp)
 {
   vfm_symb_t* symb = vfm_addr2symb(cp, &mp->dict);
@@ -57,17 +90,37 @@ static void ftrace(FILE* file, int depth, vfm_code_t* cp, vfm_mod_t* mp)
 }
 #endif
 
+#if !defined(VFM_INSTRUMENTED_ENGINE)
+
 // TODO: Get this done automatically before main if possible
 
 int vfm_init()
 {
-  return (vfm_run(0));
+  return (vfm_run_fast(0));
 }
 
+// NB: Run environment in engine given by status; tracing and profiling
+// NB: in the instrumented engine. Continue in the other engine on switch
+
+int vfm_run(vfm_env_t* env) 
+{
+  int res;
+
+  if (!env) return (vfm_init());
+  do {
+    if (env->status & VFM_INSTRUMENTED_STATUS)
+      res = vfm_run_instrumented(env);
+    else
+      res = vfm_run_fast(env);
+  } while (res == VFM_SWITCH);
+  return (res);
+}
+#endif
+
 // TODO: Add document block per operation and use a script to extract
 // TODO: Extension operation to call C function through table
 
-int vfm_run(vfm_env_t* env) 
+int VFM_RUN(vfm_env_t* env) 
 {
 
 #include "optab.i"
@@ -95,19 +148,23 @@ int vfm_run(vfm_env_t* env)
     return (VFM_ERR);
   }
 
+  __sync_fetch_and_add(&vfm_tasks, 1);
+
 #if defined(VFM_USE_NEXT_POINTER) 
   // Restore correct inner interpreter
   np = (env->status & VFM_TRACING_STATUS) ? &&TRACING : np;
   if (np == &&NEXT && (env->status & VFM_PROFILING_STATUS))
     np = &&PROFILING;
-  // Get the profiling data right
-  if (np != &&NEXT) {
+  // Get the profiling data right; entry is not counted when resuming
+  if (np != &&NEXT && !(env->status & VFM_RESUME_STATUS)) {
     vfm_oprefcnt[VFM_OP_NEST] += 1;
     inc_refcnt(ip, &mp->dict);
   }
 #endif
+  env->status &= ~VFM_RESUME_STATUS;
 
-  // Let go!
+  // Let go; serve any pending requests first
+  if (vfm_request) goto REQUEST;
   NEXT();
 
 // NB: EXT0...EXT3 should be opcode (0..3) as opcode is page number
@@ -115,19 +172,19 @@ int vfm_run(vfm_env_t* env)
 // NB: EXT0..EXT3 are extension pages for future usage
 // NB: Allows 1024 opcodes (primitive instructions)
 
-OP(EXT0)
+OP(EXT0) // [1]
   ir = (*(ip++) & 0xff);
   goto *optab[ir];
 
-OP(EXT1)
+OP(EXT1) // [1]
   ir = 0x100 | (*(ip++) & 0xff);
   goto *optab[ir];
 
-OP(EXT2)
+OP(EXT2) // [1]
   ir = 0x200 | (*(ip++) & 0xff);
   goto *optab[ir];
 
-OP(EXT3)
+OP(EXT3) // [1]
   ir = 0x300 | (*(ip++) & 0xff);
   goto *optab[ir];
 
@@ -135,7 +192,7 @@ OP(EXT3)
 // NB: Negative opcode are implicit msb of 16 bit ip relative offset
 // NB: Relative to the instruction pointer after reading the offset
 
-OP(NEXT)
+OP(NEXT) // nop ( -- )
   if ((ir = *ip++) >= 0)
     goto *optab[ir];
 #if !defined(VFM_USE_NEXT_POINTER)
@@ -144,8 +201,44 @@ OP(NEXT)
   ir = ((ir << 8) | (*(ip++) & 0xff));
   *++rp = ip;
   ip = ip + ir;
+  if (vfm_request) goto REQUEST;
   goto NEXT;
 
+// NB: External requests (signal handlers) are polled on run, function
+// NB: and module call, and backward branch. The safepoint request is
+// NB: left for the other environments; the state is saved and the
+// NB: environment is parked until the request is withdrawn
+
+ REQUEST:
+  tmp = __sync_fetch_and_and(&vfm_request, VFM_SAFEPOINT_REQUEST);
+  if (tmp & (VFM_SNAPSHOT_REQUEST | VFM_SAFEPOINT_REQUEST)) {
+    env->sp = sp;
+    if (sp != env->sp0) *++env->sp = tos;
+    env->ip = ip;
+    env->rp = rp;
+    env->dp = dp;
+    env->mp = mp;
+  }
+  if (tmp & VFM_SNAPSHOT_REQUEST) vfm_snapshot(env);
+  if (tmp & VFM_SAFEPOINT_REQUEST) vfm_park(env);
+  if (tmp & VFM_PROFILE_REQUEST) {
+    env->status ^= VFM_PROFILING_STATUS;
+    goto ENGINE;
+  }
+  NEXT();
+
+// NB: Select inner interpreter after status change; switch engine when
+// NB: tracing and profiling is turned on (fast) or off (instrumented)
+
+ ENGINE:
+#if defined(VFM_USE_NEXT_POINTER)
+  if (!(env->status & VFM_INSTRUMENTED_STATUS)) goto SWITCH;
+  np = (env->status & VFM_TRACING_STATUS) ? &&TRACING : &&PROFILING;
+#else
+  if (env->status & VFM_INSTRUMENTED_STATUS) goto SWITCH;
+#endif
+  NEXT();
+
 OP(TRACING)
 #if defined(VFM_USE_NEXT_POINTER)
   while ((ir = *ip++) < 0) {
@@ -156,11 +249,14 @@ OP(TRACING)
     ftrace(stdout, rp - env->rp0, ip, mp);
     fprintf(stdout, "\n");
     vfm_oprefcnt[VFM_OP_NEST] += 1;
+    if (env->status & VFM_NGRAM_STATUS) vfm_ngram_count(VFM_OP_NEST);
+    if (vfm_request) goto REQUEST;
   }
   fprintf(stdout, "%8s ", opname[(unsigned) ir]);
 
   // Check for some special trace cases; module call, select call
-  if (ir == VFM_OP_MEST) {
+  if (ir == VFM_OP_MEST && (VFM_LOADED(mp->use.mod[(int) *ip]) 
+			    || !vfm_resolve(mp->use.mod[(int) *ip]))) {
     int i = *ip;
     tmp = ((*(ip + 1) << 8) | (*(ip + 2) & 0xff));
     vfm_code_t* tp = mp->use.mod[i]->segment.code + tmp;
@@ -191,6 +287,7 @@ OP(TRACING)
     } 
   }
   fprintf(stdout, "\n");
+  if (env->status & VFM_NGRAM_STATUS) vfm_ngram_count(ir);
   vfm_oprefcnt[ir] += 1;
   goto *optab[ir];
 #else
@@ -200,14 +297,18 @@ OP(TRACING)
 OP(PROFILING)
 #if defined(VFM_USE_NEXT_POINTER)
   while ((ir = *ip++) < 0) {
+    inc_opcnt(ip - 1, mp);
     ir = ((ir << 8) | (*(ip++) & 0xff));
     *++rp = ip;
     ip = ip + ir;
     inc_refcnt(ip, &mp->dict);
     vfm_oprefcnt[VFM_OP_NEST] += 1;
+    if (env->status & VFM_NGRAM_STATUS) vfm_ngram_count(VFM_OP_NEST);
+    if (vfm_request) goto REQUEST;
   }
   // Check for some special profiling cases; module call, select call
-  if (ir == VFM_OP_MEST) {
+  if (ir == VFM_OP_MEST && (VFM_LOADED(mp->use.mod[(int) *ip]) 
+			    || !vfm_resolve(mp->use.mod[(int) *ip]))) {
     int i = *ip;
     tmp = ((*(ip + 1) << 8) | (*(ip + 2) & 0xff));
     vfm_code_t* tp = mp->use.mod[i]->segment.code + tmp;
@@ -225,6 +326,8 @@ OP(PROFILING)
     tp = tp + tmp;
     inc_refcnt(tp, &mp->dict);
   }
+  if (env->status & VFM_NGRAM_STATUS) vfm_ngram_count(ir);
+  inc_opcnt(ip - 1, mp);
   vfm_oprefcnt[ir] += 1;
   goto *optab[ir];
 #else
@@ -233,14 +336,14 @@ OP(PROFILING)
 
 // NB: NEST is an implicit operation in the token threaded inner interpreter
 
-OP(NEST)
+OP(NEST) // [2]
   ir = *ip++;
   ir = ((ir << 8) | (*(ip++) & 0xff));
   *++rp = ip;
   ip = ip + ir;
   NEXT();
 
-OP(NNEST)
+OP(NNEST) // [-1]
   ir = *ip++;
   tmp = 2 * tos;
   tos = *sp--;
@@ -265,29 +368,34 @@ OP(UNNEZE)
   NEXT();
  
 // NB: MEST is a module call that requires module index(int8) and offset(int16)
+// NB: The used module may be a stub (lazy loading) and is loaded on first call
 // TODO: Add full symbolic module call (runtime lookup of symbol)
 // TODO: Performance enhance with reference caching (rewriting)
 
-OP(MEST)
+OP(MEST) // [3]
   ir = *ip++;
   *(++rp) = (vfm_code_t*) mp;
   mp = mp->use.mod[ir];
+  if (!VFM_LOADED(mp) && vfm_resolve(mp)) goto UNRESOLVED;
   ir = *ip++;
   ir = ((ir << 8) | (*(ip++) & 0xff));
   *(++rp) = ip;
   ip = mp->segment.code + ir;
+  if (vfm_request) goto REQUEST;
   NEXT();
 
 // NB: MESTI is a module call that requires module index(int8) and symbol index(int8)
 // NB: This requires that symbols are loaded. Should be checked or flagged in object header.
 
-OP(MESTI)
+OP(MESTI) // [2]
   ir = *ip++;
   *(++rp) = (vfm_code_t*) mp;
   mp = mp->use.mod[ir];
+  if (!VFM_LOADED(mp) && vfm_resolve(mp)) goto UNRESOLVED;
   ir = (unsigned) *ip++;
   *(++rp) = ip;
   ip = mp->dict.symbols[ir].code;
+  if (vfm_request) goto REQUEST;
   NEXT();
 
 OP(UNMEST)
@@ -305,7 +413,7 @@ OP(UNSLIT)
   ip = *rp--;
   NEXT();
 
-OP(UNLIT)
+OP(UNLIT) // [4]
   *++sp = tos;
   tos = (vfm_data_t) *ip++;
   tos = ((tos << 8) | (*(ip++) & 0xff));
@@ -314,56 +422,63 @@ OP(UNLIT)
   ip = *rp--;
   NEXT();
 
-OP(BRA)
+OP(BRA) // [1]
   ir = *ip++;
   ip = ip + ir; 
+  POLL(ir);
   NEXT();
 
-OP(BRAX)
+OP(BRAX) // [2]
   ir = *ip++;
   ir = ((ir << 8) | (*(ip++) & 0xff));
   ip = ip + ir; 
+  POLL(ir);
   NEXT();
 
 // NB: Conditional operations are optimized for non stalling pipeline
 
-OP(BRZX)
+OP(BRZX) // [2]
   ir = *ip++;
   ir = ((ir << 8) | (*(ip++) & 0xff));
   ip = ip + ((-(tos == 0)) & ir);
   tos = *sp--;
+  POLL(ir);
   NEXT();
 
-OP(BRZE)
+OP(BRZE) // [1]
   ir = *ip++;
   ip = ip + ((-(tos == 0)) & ir);
   tos = *sp--;
+  POLL(ir);
   NEXT();    
 
-OP(BRZN)
+OP(BRZN) // [1]
   ir = *ip++;
   ip = ip + ((-(tos != 0)) & ir);
   tos = *sp--;
+  POLL(ir);
   NEXT();    
 
-OP(DBZN)
+OP(DBZN) // [1]
   ir = *ip++;
   if (--tos >= 0)
     ip = ip + ir;
   else
     tos = *sp--;
+  POLL(ir);
   NEXT();    
 
-OP(RBZN)
+OP(RBZN) // [1]
   ir = *ip++;
   *rp = *rp - 1;
   if (((int) *rp) >= 0)
     ip = ip + ir;
   else
     rp = rp - 1;
+  POLL(ir);
   NEXT();    
 
-OP(RDBG)
+OP(RDBG) // [1]
   ir = *ip++;
   *rp = *rp - tos;
   if (((int) *rp) >= 0)
@@ -371,9 +486,10 @@ OP(RDBG)
   else
     rp = rp - 1;
   tos = *sp--;
+  POLL(ir);
   NEXT();    
 
-OP(RBRI)
+OP(RBRI) // [1]
   if (tos < *sp) {
     *++rp = (vfm_code_t*) tos;
     *++rp = (vfm_code_t*) *sp--;
@@ -386,16 +502,17 @@ OP(RBRI)
   }
   NEXT();
 
-OP(RBNE)
+OP(RBNE) // [1]
   ir = *ip++;
   *rp = *rp + 1;
   if (*rp <= *(rp - 1))
     ip = ip + ir;
   else
     rp = rp - 2;
+  POLL(ir);
   NEXT();    
 
-OP(RDNE)
+OP(RDNE) // [1]
   ir = *ip++;
   *rp = *rp + tos;
   if (*rp <= *(rp - 1))
@@ -403,21 +520,22 @@ OP(RDNE)
   else
     rp = rp - 2;
   tos = *sp--;
+  POLL(ir);
   NEXT();    
 
-OP(TASK)
+OP(TASK) // task ( -- addr )
   *++sp = tos;
   tos = (vfm_data_t) env;
   NEXT();
 
-OP(LOCAL)
+OP(LOCAL) // [2]
   ir = *ip++;
   ir = ((ir << 8) | (*(ip++) & 0xff));
   *++sp = tos;
   tos = (vfm_data_t) (env->dp0 + (unsigned) ir);
   NEXT();
 
-OP(HERE)
+OP(HERE) // here ( -- addr )
   *++sp = tos;
   tos = (vfm_data_t) dp;
   NEXT();
@@ -428,32 +546,23 @@ OP(ALLOT)
   NEXT(); 
 
 OP(TRACE)
-#if defined(VFM_USE_NEXT_POINTER)
-  if (tos) {
-    np = &&TRACING;
+  if (tos)
     env->status |= VFM_TRACING_STATUS;
-  } else {
-    np = (env->status & VFM_PROFILING_STATUS) ? &&PROFILING : &&NEXT;
+  else
     env->status &= ~VFM_TRACING_STATUS;
-  }
-#endif
   tos = *sp--;
-  NEXT();
+  goto ENGINE;
 
 OP(PROFILE)
-#if defined(VFM_USE_NEXT_POINTER)
   if (tos) {
-    if (!(env->status & VFM_TRACING_STATUS)) np = &&PROFILING;
     env->status |= VFM_PROFILING_STATUS;
     if (tos == 1)
       vfm_reset_counters(mp);
   } else {
-    np = (env->status & VFM_TRACING_STATUS) ? &&TRACING : &&NEXT;
     env->status &= ~VFM_PROFILING_STATUS;
   }
-#endif
   tos = *sp--;
-  NEXT();
+  goto ENGINE;
 
 // NB: Problem with passing addresses between modules
 // TODO: Fix function pointer with module and offset (as MEST)
@@ -461,44 +570,44 @@ OP(PROFILE)
 // TODO: Compiler 'execute' should compile EXEC and UNMEST
 // TODO: Compiler symbol quote should compile module and symbol offset
 
-OP(EXEC)
+OP(EXEC) // execute ( xt -- )
   *++rp = ip;
   ip = (vfm_code_t*) tos;
   tos = *sp--;
   NEXT();   
 
-OP(CLOAD)
+OP(CLOAD) // c@ ( addr -- c )
   tos = *((char*) tos);
   NEXT();
 
-OP(CSTORE)
+OP(CSTORE) // c! ( c addr -- )
   *((char*) tos) = *sp--;
   tos = *sp--;
   NEXT();
 
-OP(LOAD)
+OP(LOAD) // @ ( addr -- x )
   tos = *((vfm_data_t*) tos);
   NEXT();
 
-OP(STORE)
+OP(STORE) // ! ( x addr -- )
   *((vfm_data_t*) tos) = *sp--;
   tos = *sp--;
   NEXT();
 
-OP(ICLOAD)
+OP(ICLOAD) // +c@ ( 0 addr -- c )
   tos = *((char*) tos + *sp--);
   NEXT();
 
-OP(ICSTORE)
+OP(ICSTORE) // +c! ( c addr -- )
   *((char*) tos) += *sp--;
   tos = *sp--;
   NEXT();
 
-OP(ILOAD)
+OP(ILOAD) // +@ ( 0 addr -- x )
   tos = *((vfm_data_t*) tos + *sp--);
   NEXT();
 
-OP(ISTORE)
+OP(ISTORE) // +! ( x addr -- )
   *((vfm_data_t*) tos) += *sp--;
   tos = *sp--;
   NEXT();
@@ -523,12 +632,12 @@ OP(RPOP)
   tos = (vfm_data_t) *rp--;
   NEXT();
 
-OP(RCOPY)
+OP(RCOPY) // i ( -- x )
   *++sp = tos;
   tos = (vfm_data_t) *rp;
   NEXT();
 
-OP(LIT)
+OP(LIT) // 1000 ( -- x ) [4]
   *++sp = tos; 
   tos = (vfm_data_t) *ip++;
   tos = ((tos << 8) | (*(ip++) & 0xff));
@@ -536,89 +645,89 @@ OP(LIT)
   tos = ((tos << 8) | (*(ip++) & 0xff));
   NEXT();
 
-OP(CLIT)
+OP(CLIT) // 100 ( -- x ) [1]
   *++sp = tos; 
   tos = (vfm_data_t) *ip++;
   NEXT();
 
-OP(PLIT)
+OP(PLIT) // [2]
   *++sp = tos; 
   ir = *ip++;
   ir = ((ir << 8) | (*(ip++) & 0xff));
   tos = (vfm_data_t) (ip + ir);
   NEXT();
 
-OP(SLIT)
+OP(SLIT) // [-1]
   ir = *ip++;
   *++sp = tos;
   tos = (int) ip;
   ip = ip + (unsigned) ir; 
   NEXT();
 
-OP(DEPTH)
+OP(DEPTH) // depth ( -- n )
   tmp = (sp - env->sp0);
   *++sp = tos;
   tos = tmp;
   NEXT();
 
-OP(DROP)
+OP(DROP) // drop ( x -- )
   tos = *sp--;
   NEXT();
 
-OP(NIP)
+OP(NIP) // nip ( x y -- y )
   sp -= 1;
   NEXT();
 
-OP(EMPTY)
+OP(EMPTY) // empty ( -- )
   sp = env->sp0;
   NEXT();
 
-OP(DUP)
+OP(DUP) // dup ( x -- x x )
   *++sp = tos;
   NEXT();
 
-OP(DUPNZ)
+OP(DUPNZ) // ?dup ( x -- x x )
   if (tos != 0) 
     *++sp = tos;
   NEXT();
 
-OP(OVER)
+OP(OVER) // over ( x y -- x y x )
   tmp = *sp;
   *++sp = tos;
   tos = tmp;
   NEXT();
 
-OP(TUCK)
+OP(TUCK) // tuck ( x y -- y x y )
   tmp = *sp;
   *sp = tos;
   *++sp = tmp;
   NEXT();
 
-OP(PICK)
+OP(PICK) // pick ( x y 1 -- x y x )
   tos = *(sp - tos);
   NEXT();
 
-OP(SWAP)
+OP(SWAP) // swap ( x y -- y x )
   tmp = tos;
   tos = *sp;
   *sp = tmp;
   NEXT();
 
-OP(ROT)
+OP(ROT) // rot ( x y z -- y z x )
   tmp = tos;
   tos = *(sp - 1);
   *(sp - 1) = *sp;
   *sp = tmp;
   NEXT();
 
-OP(TOR)
+OP(TOR) // -rot ( x y z -- z x y )
   tmp = tos;
   tos = *sp;
   *sp = *(sp - 1);
   *(sp - 1) = tmp;
   NEXT();
 
-OP(ROLL)
+OP(ROLL) // roll ( x y 1 -- y x )
   if (tos > 0) {
     sp[0] = sp[-tos];
     for (; tos > 0; tos--)
@@ -627,197 +736,197 @@ OP(ROLL)
   tos = *sp--;
   NEXT();
 
-OP(CELL)
+OP(CELL) // cell ( -- n )
   *++sp = tos;
   tos = sizeof(vfm_data_t);
   NEXT();
 
-OP(CONSTN2)
+OP(CONSTN2) // -2 ( -- n )
   *++sp = tos;
   tos = -2;
   NEXT();
 
-OP(CONSTN1)
+OP(CONSTN1) // -1 ( -- n )
   *++sp = tos;
   tos = -1;
   NEXT();
 
-OP(CONST0)
+OP(CONST0) // 0 ( -- n )
   *++sp = tos;
   tos = 0;
   NEXT();
 
-OP(CONST1)
+OP(CONST1) // 1 ( -- n )
   *++sp = tos;
   tos = 1;
   NEXT();
 
-OP(CONST2)
+OP(CONST2) // 2 ( -- n )
   *++sp = tos;
   tos = 2;
   NEXT();
 
-OP(CONST3)
+OP(CONST3) // 3 ( -- n )
   *++sp = tos;
   tos = 3;
   NEXT();
 
-OP(TRUE)
+OP(TRUE) // true ( -- flag )
   *++sp = tos;
   tos = -1;
   NEXT();
 
-OP(FALSE)
+OP(FALSE) // false ( -- flag )
   *++sp = tos;
   tos = 0;
   NEXT();
 
-OP(NOT)
+OP(NOT) // not ( x -- y )
   tos = ~tos;
   NEXT();
 
-OP(AND)
+OP(AND) // and ( x y -- z )
   tos = *sp-- & tos;
   NEXT();
 
-OP(OR)
+OP(OR) // or ( x y -- z )
   tos = *sp-- | tos;
   NEXT();
 
-OP(XOR)
+OP(XOR) // xor ( x y -- z )
   tos = *sp-- ^ tos;
   NEXT();
 
-OP(NEG)
+OP(NEG) // negate ( x -- y )
   tos = -tos;
   NEXT();
     
-OP(INC)
+OP(INC) // 1+ ( x -- y )
   tos += 1;
   NEXT();
 
-OP(DEC)
+OP(DEC) // 1- ( x -- y )
   tos -= 1;
   NEXT();
 
-OP(INC2)
+OP(INC2) // 2+ ( x -- y )
   tos += 2;
   NEXT();
 
-OP(DEC2)
+OP(DEC2) // 2- ( x -- y )
   tos -= 2;
   NEXT();
 
-OP(MUL2)
+OP(MUL2) // 2* ( x -- y )
   tos <<= 1;
   NEXT();
 
-OP(DIV2)
+OP(DIV2) // 2/ ( x -- y )
   tos >>= 1;
   NEXT();
 
-OP(ADD)
+OP(ADD) // + ( x y -- z )
   tos = *sp-- + tos;
   NEXT();
 
-OP(SUB)
+OP(SUB) // - ( x y -- z )
   tos = *sp-- - tos;
   NEXT();
 
-OP(MUL)
+OP(MUL) // * ( x y -- z )
   tos = *sp-- * tos;
   NEXT();
 
-OP(MULDIV)
+OP(MULDIV) // */ ( x y z -- w )
   tmp = *sp--;
   tos = (((vfm_data2_t) tos) * (*sp--)) / tmp;
   NEXT();
 
-OP(DIV)
+OP(DIV) // / ( x y -- z )
   tos = *sp-- / tos;
   NEXT();
 
-OP(REM)
+OP(REM) // % ( x y -- z )
   tos = *sp-- % tos;
   NEXT();
 
-OP(DIVREM)
+OP(DIVREM) // /% ( x y -- z w )
   tmp = *sp / tos;
   tos = *sp % tos;
   *sp = tmp;
   NEXT();
 
-OP(LSH)
+OP(LSH) // << ( x n -- y )
   tos = *sp-- << tos;
   NEXT();
 
-OP(RSH)
+OP(RSH) // >> ( x n -- y )
   tos = *sp-- >> tos;
   NEXT();
 
-OP(ZNE)
+OP(ZNE) // 0<> ( x -- flag )
   tos = -(tos != 0);
   NEXT();
 
-OP(ZLT)
+OP(ZLT) // 0< ( x -- flag )
   tos = -(tos < 0);
   NEXT();
 
-OP(ZLE)
+OP(ZLE) // 0<= ( x -- flag )
   tos = -(tos <= 0);
   NEXT();
 
-OP(ZEQ)
+OP(ZEQ) // 0= ( x -- flag )
   tos = -(tos == 0);
   NEXT();
 
-OP(ZGE)
+OP(ZGE) // 0>= ( x -- flag )
   tos = -(tos >= 0);
   NEXT();
 
-OP(ZGT)
+OP(ZGT) // 0> ( x -- flag )
   tos = -(tos > 0);
   NEXT();
 
-OP(NE)
+OP(NE) // != ( x y -- flag )
   tos = -(*sp-- != tos);
   NEXT();
 
-OP(LT)
+OP(LT) // < ( x y -- flag )
   tos = -(*sp-- < tos);
   NEXT();
 
-OP(LE)
+OP(LE) // <= ( x y -- flag )
   tos = -(*sp-- <= tos);
   NEXT();
 
-OP(EQ)
+OP(EQ) // == ( x y -- flag )
   tos = -(*sp-- == tos);
   NEXT();
 
-OP(GE)
+OP(GE) // >= ( x y -- flag )
   tos = -(*sp-- >= tos);
   NEXT();
 
-OP(GT)
+OP(GT) // > ( x y -- flag )
   tos = -(*sp-- > tos);
   NEXT();
 
-OP(WITHIN)
+OP(WITHIN) // within ( x lo hi -- flag )
   tmp = *sp--;
   tos = -((*sp <= tos) & (*sp >= tmp));
   NEXT();
 
-OP(ABS)
+OP(ABS) // abs ( x -- y )
   tos = ((-(tos < 0)) & (-tos)) | ((-(tos >= 0)) & tos);
   NEXT();
 
-OP(MIN)
+OP(MIN) // min ( x y -- z )
   tos = ((-(tos < *sp) & tos) | (-(tos >= *sp) & *sp));
   sp = sp - 1;
   NEXT();
 
-OP(MAX)
+OP(MAX) // max ( x y -- z )
   tos = ((-(tos > *sp) & tos) | (-(tos <= *sp) & *sp));
   sp = sp - 1;
   NEXT();
@@ -882,12 +991,93 @@ OP(IDENT)
   NEXT();
 
 OP(HALT)
+  __sync_fetch_and_sub(&vfm_tasks, 1);
+  if (sp != env->sp0) *++sp = tos;
+  env->sp = sp;
+  env->ip = ip;
+  env->rp = rp;
+  env->dp = dp;
+  env->mp = mp;
+  return ((env->status & VFM_RESUME_STATUS) ? VFM_SWITCH : 0);
+
+// NB: Superinstructions; fused operation sequences selected by the
+// NB: compiler peephole optimizer (compiler.c::gen_super). The name is
+// NB: the list of fused operations (see makefile, supertab.i). They are
+// NB: appended after HALT so that the base operation codes are kept.
+
+OP(OVER_EQ_BRZE) // [1]
+  ir = *ip++;
+  ip = ip + ((-(tos != *sp)) & ir);
+  tos = *sp--;
+  POLL(ir);
+  NEXT();
+
+OP(DUP_BRZE) // [1]
+  ir = *ip++;
+  ip = ip + ((-(tos == 0)) & ir);
+  POLL(ir);
+  NEXT();
+
+OP(CLIT_ADD) // 100 + ( x -- y ) [1]
+  tos += (vfm_data_t) *ip++;
+  NEXT();
+
+OP(LIT_STORE) // [4]
+  ir = (vfm_data_t) *ip++;
+  ir = ((ir << 8) | (*(ip++) & 0xff));
+  ir = ((ir << 8) | (*(ip++) & 0xff));
+  ir = ((ir << 8) | (*(ip++) & 0xff));
+  *((vfm_data_t*) ir) = tos;
+  tos = *sp--;
+  NEXT();
+
+OP(RPUSH_RPUSH)
+  *++rp = (vfm_code_t*) tos;
+  *++rp = (vfm_code_t*) *sp--;
+  tos = *sp--;
+  NEXT();
+
+OP(RCOPY_ADD) // i + ( x -- y )
+  tos += (vfm_data_t) *rp;
+  NEXT();
+
+// NB: Engine switch; state is saved as on halt and resumed by vfm_run
+
+ SWITCH:
+  env->status |= VFM_RESUME_STATUS;
+  goto HALT;
+
+// NB: Module call to a used module that could not be loaded (lazy).
+// NB: Only the module index has been read (MEST, MESTI); the state is
+// NB: saved with the instruction pointer at the operation so that the
+// NB: call is retried when the environment is resumed
+
+ UNRESOLVED: __attribute__((unused));
+  mp = (vfm_mod_t*) *rp--;
+  ip -= 2;
+  __sync_fetch_and_sub(&vfm_tasks, 1);
+  if (sp != env->sp0) *++sp = tos;
+  env->sp = sp;
+  env->ip = ip;
+  env->rp = rp;
+  env->dp = dp;
+  env->mp = mp;
+  return (vfm_errno);
+
+#if defined(VFM_SPECIAL_ENGINE)
+// NB: Operations not in the specialized engine (special.c) trap.
+// NB: State is saved with the instruction pointer after the operation
+
+ TRAP:
+  vfm_errno = VFM_TRAP_ERR;
+  __sync_fetch_and_sub(&vfm_tasks, 1);
   if (sp != env->sp0) *++sp = tos;
   env->sp = sp;
   env->ip = ip;
   env->rp = rp;
   env->dp = dp;
   env->mp = mp;
-  return (0);
+  return (VFM_TRAP_ERR);
+#endif
 }
 
@@ -0,0 +1,3649 @@
+	.file	"runtime.c"
+	.text
+	.section	.rodata.str1.1,"aMS",@progbits,1
+.LC0:
+	.string	"[%d] "
+.LC1:
+	.string	"%d "
+.LC2:
+	.string	"%d"
+.LC3:
+	.string	"0x%x "
+	.text
+	.globl	vfm_run_fast
+	.type	vfm_run_fast, @function
+vfm_run_fast:
+.LFB2:
+	.cfi_startproc
+	testq	%rdi, %rdi
+	jne	.L2
+	leaq	optab.1(%rip), %rax
+	movq	%rax, vfm_optab(%rip)
+	leaq	opname.0(%rip), %rax
+	movq	%rax, vfm_opname(%rip)
+	xorl	%eax, %eax
+	ret
+.L2:
+	pushq	%r15
+	.cfi_def_cfa_offset 16
+	.cfi_offset 15, -16
+	xorl	%ecx, %ecx
+	pushq	%r14
+	.cfi_def_cfa_offset 24
+	.cfi_offset 14, -24
+	pushq	%r13
+	.cfi_def_cfa_offset 32
+	.cfi_offset 13, -32
+	movq	%rdi, %r13
+	pushq	%r12
+	.cfi_def_cfa_offset 40
+	.cfi_offset 12, -40
+	pushq	%rbp
+	.cfi_def_cfa_offset 48
+	.cfi_offset 6, -48
+	pushq	%rbx
+	.cfi_def_cfa_offset 56
+	.cfi_offset 3, -56
+	subq	$40, %rsp
+	.cfi_def_cfa_offset 96
+	movq	16(%rdi), %rbp
+	cmpq	%rbp, 48(%rdi)
+	je	.L4
+	movq	0(%rbp), %rcx
+	subq	$8, %rbp
+.L4:
+	movq	8(%r13), %r12
+	movq	32(%r13), %rax
+	movq	24(%r13), %rbx
+	movq	40(%r13), %r15
+	movq	104(%r12), %rdx
+	movq	%rax, 8(%rsp)
+	orl	$-1, %eax
+	cmpq	%rdx, %rbx
+	jb	.L1
+	movslq	100(%r12), %rax
+	addq	%rax, %rdx
+	orl	$-1, %eax
+	cmpq	%rbx, %rdx
+	jb	.L1
+	lock incl	vfm_tasks(%rip)
+	movl	vfm_request(%rip), %eax
+	andl	$-17, 0(%r13)
+	testl	%eax, %eax
+	jne	.L5
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	js	.L6
+	leaq	optab.1(%rip), %rdx
+	movq	%r15, %r14
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L7
+.L24:
+#APP
+# 242 "runtime.c" 1
+	# OP(TRACING)
+# 0 "" 2
+#NO_APP
+.L13:
+#APP
+# 195 "runtime.c" 1
+	# OP(NEXT)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	js	.L309
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+.L7:
+	movq	%rax, %rbx
+.L14:
+	jmp	*%rdx
+.L8:
+#APP
+# 175 "runtime.c" 1
+	# OP(EXT0)
+# 0 "" 2
+#NO_APP
+	movzbl	(%rbx), %esi
+	leaq	optab.1(%rip), %rdx
+	leaq	1(%rbx), %rax
+	movq	(%rdx,%rsi,8), %rdx
+.L10:
+	movq	%rax, %rbx
+	jmp	.L14
+.L9:
+#APP
+# 179 "runtime.c" 1
+	# OP(EXT1)
+# 0 "" 2
+#NO_APP
+	movzbl	(%rbx), %edx
+	leaq	optab.1(%rip), %rsi
+	leaq	1(%rbx), %rax
+	orb	$1, %dh
+	movq	(%rsi,%rdx,8), %rdx
+	jmp	.L10
+.L11:
+#APP
+# 183 "runtime.c" 1
+	# OP(EXT2)
+# 0 "" 2
+#NO_APP
+	movzbl	(%rbx), %edx
+	leaq	optab.1(%rip), %rsi
+	leaq	1(%rbx), %rax
+	orb	$2, %dh
+	movq	(%rsi,%rdx,8), %rdx
+	jmp	.L10
+.L12:
+#APP
+# 187 "runtime.c" 1
+	# OP(EXT3)
+# 0 "" 2
+#NO_APP
+	movzbl	(%rbx), %edx
+	leaq	optab.1(%rip), %rsi
+	leaq	1(%rbx), %rax
+	orb	$3, %dh
+	movq	(%rsi,%rdx,8), %rdx
+	jmp	.L10
+.L309:
+	movq	%r14, %r15
+.L6:
+	leaq	1(%rax), %rbx
+	movzbl	(%rax), %eax
+	salq	$8, %rsi
+	leaq	8(%r15), %r14
+	movq	%rbx, 8(%r15)
+	orq	%rax, %rsi
+	movl	vfm_request(%rip), %eax
+	addq	%rsi, %rbx
+	testl	%eax, %eax
+	je	.L13
+	movq	%r14, %r15
+.L5:
+	movl	vfm_request(%rip), %eax
+.L15:
+	movl	%eax, %edx
+	movl	%eax, %r14d
+	andl	$4, %edx
+	lock cmpxchgl	%edx, vfm_request(%rip)
+	jne	.L15
+	testb	$5, %r14b
+	je	.L16
+	movq	%rbp, 16(%r13)
+	cmpq	%rbp, 48(%r13)
+	je	.L17
+	leaq	8(%rbp), %rax
+	movq	%rax, 16(%r13)
+	movq	%rcx, 8(%rbp)
+.L17:
+	movq	8(%rsp), %rax
+	movq	%rbx, 24(%r13)
+	movq	%r15, 40(%r13)
+	movq	%rax, 32(%r13)
+	movq	%r12, 8(%r13)
+.L16:
+	testb	$1, %r14b
+	je	.L18
+	movq	%r13, %rdi
+	movq	%rcx, 16(%rsp)
+	call	vfm_snapshot@PLT
+	movq	16(%rsp), %rcx
+.L18:
+	testb	$4, %r14b
+	je	.L19
+	movq	%r13, %rdi
+	movq	%rcx, 16(%rsp)
+	call	vfm_park@PLT
+	movq	16(%rsp), %rcx
+.L19:
+	andb	$2, %r14b
+	je	.L20
+	xorl	$2, 0(%r13)
+	jmp	.L21
+.L20:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	js	.L6
+	leaq	optab.1(%rip), %rdx
+	movq	%r15, %r14
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L7
+.L108:
+#APP
+# 548 "runtime.c" 1
+	# OP(TRACE)
+# 0 "" 2
+#NO_APP
+	testq	%rcx, %rcx
+	je	.L109
+	movl	0(%r13), %eax
+	orl	$1, %eax
+.L110:
+	movl	%eax, 0(%r13)
+	movq	0(%rbp), %rcx
+	movq	%r14, %r15
+	subq	$8, %rbp
+.L21:
+	movl	0(%r13), %eax
+	testb	$3, %al
+	je	.L22
+	orl	$16, %eax
+	movq	%r15, %r14
+	movl	%eax, 0(%r13)
+	jmp	.L23
+.L22:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	js	.L6
+	leaq	optab.1(%rip), %rdx
+	movq	%r15, %r14
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L7
+.L25:
+#APP
+# 297 "runtime.c" 1
+	# OP(PROFILING)
+# 0 "" 2
+#NO_APP
+	jmp	.L13
+.L26:
+#APP
+# 339 "runtime.c" 1
+	# OP(NEST)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	movzbl	1(%rbx), %eax
+	leaq	2(%rbx), %rdx
+	addq	$8, %r14
+	movq	%rdx, (%r14)
+	salq	$8, %rsi
+	orq	%rsi, %rax
+	addq	%rax, %rdx
+	movsbq	(%rdx), %rsi
+	leaq	1(%rdx), %rax
+	testq	%rsi, %rsi
+	jns	.L27
+	movq	%r14, %r15
+	jmp	.L6
+.L27:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L28:
+#APP
+# 346 "runtime.c" 1
+	# OP(NNEST)
+# 0 "" 2
+#NO_APP
+	leal	(%rcx,%rcx), %eax
+	movq	%rbp, %rcx
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rdx
+	movq	(%rcx), %rcx
+	subq	$8, %rbp
+	testl	%eax, %eax
+	js	.L29
+	cmpl	%eax, %esi
+	jle	.L29
+	addq	%rdx, %rsi
+	addq	%rdx, %rax
+	addq	$8, %r14
+	movq	%rsi, (%r14)
+	movsbq	(%rax), %rdi
+	leaq	2(%rax), %rdx
+	movzbl	1(%rax), %esi
+	salq	$8, %rdi
+	orq	%rdi, %rsi
+.L29:
+	addq	%rsi, %rdx
+	movsbq	(%rdx), %rsi
+	leaq	1(%rdx), %rax
+	testq	%rsi, %rsi
+	jns	.L30
+	movq	%r14, %r15
+	jmp	.L6
+.L30:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L31:
+#APP
+# 359 "runtime.c" 1
+	# OP(UNNEST)
+# 0 "" 2
+#NO_APP
+	movq	%r14, %rax
+	subq	$8, %r14
+	movq	(%rax), %rdx
+	movsbq	(%rdx), %rsi
+	leaq	1(%rdx), %rax
+	testq	%rsi, %rsi
+	jns	.L32
+	movq	%r14, %r15
+	jmp	.L6
+.L32:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L33:
+#APP
+# 363 "runtime.c" 1
+	# OP(UNNEZE)
+# 0 "" 2
+#NO_APP
+	testq	%rcx, %rcx
+	jne	.L34
+	movq	0(%rbp), %rcx
+	movq	(%r14), %rbx
+	subq	$8, %rbp
+	subq	$8, %r14
+.L34:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L35
+	movq	%r14, %r15
+	jmp	.L6
+.L35:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L36:
+#APP
+# 375 "runtime.c" 1
+	# OP(MEST)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rax
+	movq	40(%r12), %rdx
+	movq	%r12, 8(%r14)
+	leaq	8(%r14), %r15
+	movq	(%rdx,%rax,8), %r12
+	movq	104(%r12), %rax
+	testq	%rax, %rax
+	je	.L37
+.L40:
+	movsbq	1(%rbx), %rdx
+	movzbl	2(%rbx), %eax
+	addq	$3, %rbx
+	leaq	8(%r15), %r14
+	movq	%rbx, 8(%r15)
+	salq	$8, %rdx
+	orq	%rdx, %rax
+	addq	104(%r12), %rax
+	movq	%rax, %rbx
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L38
+	movq	%r14, %r15
+	jmp	.L5
+.L37:
+	movq	%r12, %rdi
+	movq	%rcx, 16(%rsp)
+	call	vfm_resolve@PLT
+	movq	16(%rsp), %rcx
+	testl	%eax, %eax
+	je	.L40
+	incq	%rbx
+	jmp	.L46
+.L38:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L41
+	movq	%r14, %r15
+	jmp	.L6
+.L41:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L42:
+#APP
+# 390 "runtime.c" 1
+	# OP(MESTI)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rax
+	movq	40(%r12), %rdx
+	movq	%r12, 8(%r14)
+	leaq	8(%r14), %r15
+	movq	(%rdx,%rax,8), %r12
+	movq	104(%r12), %rax
+	testq	%rax, %rax
+	je	.L43
+.L45:
+	movsbl	1(%rbx), %eax
+	addq	$2, %rbx
+	leaq	8(%r15), %r14
+	movq	%rbx, 8(%r15)
+	salq	$5, %rax
+	addq	56(%r12), %rax
+	movq	8(%rax), %rbx
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L44
+	movq	%r14, %r15
+	jmp	.L5
+.L43:
+	movq	%r12, %rdi
+	movq	%rcx, 16(%rsp)
+	call	vfm_resolve@PLT
+	movq	16(%rsp), %rcx
+	testl	%eax, %eax
+	je	.L45
+	incq	%rbx
+	jmp	.L46
+.L44:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L47
+	movq	%r14, %r15
+	jmp	.L6
+.L47:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L48:
+#APP
+# 401 "runtime.c" 1
+	# OP(UNMEST)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	movq	%r14, %rax
+	subq	$8, %r14
+	movq	(%rax), %r12
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L49
+	movq	%r14, %r15
+	jmp	.L6
+.L49:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L50:
+#APP
+# 405 "runtime.c" 1
+	# OP(UNMEZT)
+# 0 "" 2
+#NO_APP
+	movq	%r14, %rax
+	movq	(%r14), %r12
+	subq	$16, %r14
+	movq	-8(%rax), %rdx
+	movsbq	(%rdx), %rsi
+	leaq	1(%rdx), %rax
+	testq	%rsi, %rsi
+	jns	.L51
+	movq	%r14, %r15
+	jmp	.L6
+.L51:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L52:
+#APP
+# 410 "runtime.c" 1
+	# OP(UNSLIT)
+# 0 "" 2
+#NO_APP
+	movq	%r14, %rax
+	movq	%rcx, 8(%rbp)
+	addq	$8, %rbp
+	movslq	%ebx, %rcx
+	movq	(%rax), %rdx
+	subq	$8, %r14
+	movsbq	(%rdx), %rsi
+	leaq	1(%rdx), %rax
+	testq	%rsi, %rsi
+	jns	.L53
+	movq	%r14, %r15
+	jmp	.L6
+.L53:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L54:
+#APP
+# 416 "runtime.c" 1
+	# OP(UNLIT)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rax
+	addq	$8, %rbp
+	movzbl	1(%rbx), %edx
+	movzbl	3(%rbx), %ecx
+	salq	$8, %rax
+	orq	%rax, %rdx
+	movzbl	2(%rbx), %eax
+	salq	$8, %rdx
+	orq	%rdx, %rax
+	salq	$8, %rax
+	orq	%rax, %rcx
+	movq	%r14, %rax
+	subq	$8, %r14
+	movq	(%rax), %rdx
+	movsbq	(%rdx), %rsi
+	leaq	1(%rdx), %rax
+	testq	%rsi, %rsi
+	jns	.L55
+	movq	%r14, %r15
+	jmp	.L6
+.L55:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L56:
+#APP
+# 425 "runtime.c" 1
+	# OP(BRA)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rdx
+	leaq	1(%rbx,%rdx), %rbx
+	testb	%dl, %dl
+	jns	.L57
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L57
+	movq	%r14, %r15
+	jmp	.L5
+.L57:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L58
+	movq	%r14, %r15
+	jmp	.L6
+.L58:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L59:
+#APP
+# 431 "runtime.c" 1
+	# OP(BRAX)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rdx
+	movzbl	1(%rbx), %eax
+	salq	$8, %rdx
+	orq	%rdx, %rax
+	leaq	2(%rbx,%rax), %rbx
+	jns	.L60
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L60
+	movq	%r14, %r15
+	jmp	.L5
+.L60:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L61
+	movq	%r14, %r15
+	jmp	.L6
+.L61:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L62:
+#APP
+# 440 "runtime.c" 1
+	# OP(BRZX)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rdx
+	movzbl	1(%rbx), %eax
+	salq	$8, %rdx
+	orq	%rdx, %rax
+	cmpq	$1, %rcx
+	sbbq	%rdx, %rdx
+	andq	%rax, %rdx
+	leaq	2(%rbx,%rdx), %rbx
+	movq	%rbp, %rdx
+	subq	$8, %rbp
+	movq	(%rdx), %rcx
+	testq	%rax, %rax
+	jns	.L63
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L63
+	movq	%r14, %r15
+	jmp	.L5
+.L63:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L64
+	movq	%r14, %r15
+	jmp	.L6
+.L64:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L65:
+#APP
+# 448 "runtime.c" 1
+	# OP(BRZE)
+# 0 "" 2
+#NO_APP
+	cmpq	$1, %rcx
+	movsbq	(%rbx), %rdx
+	sbbq	%rax, %rax
+	andq	%rdx, %rax
+	leaq	1(%rbx,%rax), %rbx
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	testq	%rdx, %rdx
+	jns	.L66
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L66
+	movq	%r14, %r15
+	jmp	.L5
+.L66:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L67
+	movq	%r14, %r15
+	jmp	.L6
+.L67:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L68:
+#APP
+# 455 "runtime.c" 1
+	# OP(BRZN)
+# 0 "" 2
+#NO_APP
+	negq	%rcx
+	movsbq	(%rbx), %rdx
+	sbbl	%eax, %eax
+	cltq
+	andq	%rdx, %rax
+	leaq	1(%rbx,%rax), %rbx
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	testq	%rdx, %rdx
+	jns	.L69
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L69
+	movq	%r14, %r15
+	jmp	.L5
+.L69:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L70
+	movq	%r14, %r15
+	jmp	.L6
+.L70:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L71:
+#APP
+# 462 "runtime.c" 1
+	# OP(DBZN)
+# 0 "" 2
+#NO_APP
+	movb	(%rbx), %al
+	leaq	1(%rbx), %rdx
+	decq	%rcx
+	js	.L72
+	movsbq	%al, %rbx
+	addq	%rdx, %rbx
+	jmp	.L73
+.L72:
+	movq	0(%rbp), %rcx
+	movq	%rdx, %rbx
+	subq	$8, %rbp
+.L73:
+	testb	%al, %al
+	jns	.L74
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L74
+	movq	%r14, %r15
+	jmp	.L5
+.L74:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L75
+	movq	%r14, %r15
+	jmp	.L6
+.L75:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L76:
+#APP
+# 471 "runtime.c" 1
+	# OP(RBZN)
+# 0 "" 2
+#NO_APP
+	movq	(%r14), %rax
+	movb	(%rbx), %dl
+	leaq	1(%rbx), %rsi
+	decq	%rax
+	movq	%rax, (%r14)
+	testl	%eax, %eax
+	js	.L77
+	movsbq	%dl, %rbx
+	addq	%rsi, %rbx
+	jmp	.L78
+.L77:
+	subq	$8, %r14
+	movq	%rsi, %rbx
+.L78:
+	testb	%dl, %dl
+	jns	.L79
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L79
+	movq	%r14, %r15
+	jmp	.L5
+.L79:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L80
+	movq	%r14, %r15
+	jmp	.L6
+.L80:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L81:
+#APP
+# 481 "runtime.c" 1
+	# OP(RDBG)
+# 0 "" 2
+#NO_APP
+	movq	(%r14), %rax
+	movb	(%rbx), %dl
+	leaq	1(%rbx), %rsi
+	subq	%rcx, %rax
+	movq	%rax, (%r14)
+	testl	%eax, %eax
+	js	.L82
+	movsbq	%dl, %rbx
+	addq	%rsi, %rbx
+	jmp	.L83
+.L82:
+	subq	$8, %r14
+	movq	%rsi, %rbx
+.L83:
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	testb	%dl, %dl
+	jns	.L84
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L84
+	movq	%r14, %r15
+	jmp	.L5
+.L84:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L85
+	movq	%r14, %r15
+	jmp	.L6
+.L85:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L86:
+#APP
+# 492 "runtime.c" 1
+	# OP(RBRI)
+# 0 "" 2
+#NO_APP
+	cmpq	%rcx, 0(%rbp)
+	jle	.L87
+	movq	0(%rbp), %rdx
+	leaq	8(%r14), %rax
+	movq	%rcx, 8(%r14)
+	subq	$16, %rbp
+	movq	8(%rbp), %rcx
+	addq	$16, %r14
+	movq	%rdx, 8(%rax)
+	jmp	.L88
+.L87:
+	movsbq	(%rbx), %rax
+	movq	-8(%rbp), %rcx
+	leaq	1(%rbx,%rax), %rbx
+.L88:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L89
+	movq	%r14, %r15
+	jmp	.L6
+.L89:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L90:
+#APP
+# 505 "runtime.c" 1
+	# OP(RBNE)
+# 0 "" 2
+#NO_APP
+	movq	(%r14), %rax
+	movb	(%rbx), %dl
+	leaq	1(%rbx), %rsi
+	incq	%rax
+	movq	%rax, (%r14)
+	cmpq	%rax, -8(%r14)
+	jb	.L91
+	movsbq	%dl, %rbx
+	addq	%rsi, %rbx
+	jmp	.L92
+.L91:
+	subq	$16, %r14
+	movq	%rsi, %rbx
+.L92:
+	testb	%dl, %dl
+	jns	.L93
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L93
+	movq	%r14, %r15
+	jmp	.L5
+.L93:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L94
+	movq	%r14, %r15
+	jmp	.L6
+.L94:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L95:
+#APP
+# 515 "runtime.c" 1
+	# OP(RDNE)
+# 0 "" 2
+#NO_APP
+	addq	(%r14), %rcx
+	movb	(%rbx), %al
+	leaq	1(%rbx), %rdx
+	movq	%rcx, (%r14)
+	cmpq	%rcx, -8(%r14)
+	jb	.L96
+	movsbq	%al, %rbx
+	addq	%rdx, %rbx
+	jmp	.L97
+.L96:
+	subq	$16, %r14
+	movq	%rdx, %rbx
+.L97:
+	movq	%rbp, %rdx
+	subq	$8, %rbp
+	movq	(%rdx), %rcx
+	testb	%al, %al
+	jns	.L98
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L98
+	movq	%r14, %r15
+	jmp	.L5
+.L98:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L99
+	movq	%r14, %r15
+	jmp	.L6
+.L99:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L100:
+#APP
+# 526 "runtime.c" 1
+	# OP(TASK)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	movq	%r13, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L101
+	movq	%r14, %r15
+	jmp	.L6
+.L101:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L102:
+#APP
+# 531 "runtime.c" 1
+	# OP(LOCAL)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rdx
+	movzbl	1(%rbx), %eax
+	movq	%rcx, 8(%rbp)
+	addq	$8, %rbp
+	movsbq	2(%rbx), %rsi
+	salq	$8, %rdx
+	orq	%rdx, %rax
+	movq	64(%r13), %rdx
+	movl	%eax, %eax
+	leaq	(%rdx,%rax,8), %rcx
+	leaq	3(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L103
+	movq	%r14, %r15
+	jmp	.L6
+.L103:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L104:
+#APP
+# 538 "runtime.c" 1
+	# OP(HERE)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	movq	8(%rsp), %rcx
+	testq	%rsi, %rsi
+	jns	.L105
+	movq	%r14, %r15
+	jmp	.L6
+.L105:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L106:
+#APP
+# 543 "runtime.c" 1
+	# OP(ALLOT)
+# 0 "" 2
+#NO_APP
+	movq	8(%rsp), %rax
+	movsbq	(%rbx), %rsi
+	leaq	(%rax,%rcx,8), %rax
+	movq	%rax, 8(%rsp)
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L107
+	movq	%r14, %r15
+	jmp	.L6
+.L107:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L109:
+	movl	0(%r13), %eax
+	andl	$-2, %eax
+	jmp	.L110
+.L111:
+#APP
+# 556 "runtime.c" 1
+	# OP(PROFILE)
+# 0 "" 2
+#NO_APP
+	testq	%rcx, %rcx
+	je	.L112
+	orl	$2, 0(%r13)
+	decq	%rcx
+	jne	.L113
+	movq	%r12, %rdi
+	call	vfm_reset_counters@PLT
+	jmp	.L113
+.L112:
+	andl	$-3, 0(%r13)
+.L113:
+	movq	0(%rbp), %rcx
+	movq	%r14, %r15
+	subq	$8, %rbp
+	jmp	.L21
+.L114:
+#APP
+# 573 "runtime.c" 1
+	# OP(EXEC)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, %rdx
+	movq	%rbx, 8(%r14)
+	movq	%rbp, %rax
+	addq	$8, %r14
+	movsbq	(%rdx), %rsi
+	movq	(%rax), %rcx
+	subq	$8, %rbp
+	leaq	1(%rdx), %rax
+	testq	%rsi, %rsi
+	jns	.L115
+	movq	%r14, %r15
+	jmp	.L6
+.L115:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L116:
+#APP
+# 579 "runtime.c" 1
+	# OP(CLOAD)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	movsbq	(%rcx), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L117
+	movq	%r14, %r15
+	jmp	.L6
+.L117:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L118:
+#APP
+# 583 "runtime.c" 1
+	# OP(CSTORE)
+# 0 "" 2
+#NO_APP
+	movq	0(%rbp), %rdx
+	movq	%rbp, %rax
+	subq	$16, %rbp
+	movb	%dl, (%rcx)
+	movsbq	(%rbx), %rsi
+	movq	-8(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L119
+	movq	%r14, %r15
+	jmp	.L6
+.L119:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L120:
+#APP
+# 588 "runtime.c" 1
+	# OP(LOAD)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	movq	(%rcx), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L121
+	movq	%r14, %r15
+	jmp	.L6
+.L121:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L122:
+#APP
+# 592 "runtime.c" 1
+	# OP(STORE)
+# 0 "" 2
+#NO_APP
+	movq	0(%rbp), %rdx
+	movq	%rbp, %rax
+	subq	$16, %rbp
+	movq	%rdx, (%rcx)
+	movsbq	(%rbx), %rsi
+	movq	-8(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L123
+	movq	%r14, %r15
+	jmp	.L6
+.L123:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L124:
+#APP
+# 597 "runtime.c" 1
+	# OP(ICLOAD)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	movsbq	(%rbx), %rsi
+	subq	$8, %rbp
+	movq	(%rax), %rax
+	movsbq	(%rax,%rcx), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L125
+	movq	%r14, %r15
+	jmp	.L6
+.L125:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L126:
+#APP
+# 601 "runtime.c" 1
+	# OP(ICSTORE)
+# 0 "" 2
+#NO_APP
+	movq	0(%rbp), %rdx
+	addb	%dl, (%rcx)
+	movq	%rbp, %rax
+	subq	$16, %rbp
+	movsbq	(%rbx), %rsi
+	movq	-8(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L127
+	movq	%r14, %r15
+	jmp	.L6
+.L127:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L128:
+#APP
+# 606 "runtime.c" 1
+	# OP(ILOAD)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	movsbq	(%rbx), %rsi
+	subq	$8, %rbp
+	movq	(%rax), %rax
+	movq	(%rcx,%rax,8), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L129
+	movq	%r14, %r15
+	jmp	.L6
+.L129:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L130:
+#APP
+# 610 "runtime.c" 1
+	# OP(ISTORE)
+# 0 "" 2
+#NO_APP
+	movq	0(%rbp), %rdx
+	addq	%rdx, (%rcx)
+	movq	%rbp, %rax
+	subq	$16, %rbp
+	movsbq	(%rbx), %rsi
+	movq	-8(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L131
+	movq	%r14, %r15
+	jmp	.L6
+.L131:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L132:
+#APP
+# 621 "runtime.c" 1
+	# OP(RPUSH)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%r14)
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	addq	$8, %r14
+	movq	(%rax), %rcx
+	subq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L133
+	movq	%r14, %r15
+	jmp	.L6
+.L133:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L134:
+#APP
+# 626 "runtime.c" 1
+	# OP(RDUP)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%r14)
+	movsbq	(%rbx), %rsi
+	addq	$8, %r14
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L135
+	movq	%r14, %r15
+	jmp	.L6
+.L135:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L136:
+#APP
+# 630 "runtime.c" 1
+	# OP(RPOP)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	movq	%r14, %rax
+	addq	$8, %rbp
+	movq	(%rax), %rcx
+	subq	$8, %r14
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L137
+	movq	%r14, %r15
+	jmp	.L6
+.L137:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L138:
+#APP
+# 635 "runtime.c" 1
+	# OP(RCOPY)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	movq	(%r14), %rcx
+	testq	%rsi, %rsi
+	jns	.L139
+	movq	%r14, %r15
+	jmp	.L6
+.L139:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L140:
+#APP
+# 640 "runtime.c" 1
+	# OP(LIT)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rax
+	addq	$8, %rbp
+	movzbl	1(%rbx), %edx
+	movzbl	3(%rbx), %ecx
+	salq	$8, %rax
+	movsbq	4(%rbx), %rsi
+	orq	%rax, %rdx
+	movzbl	2(%rbx), %eax
+	salq	$8, %rdx
+	orq	%rdx, %rax
+	salq	$8, %rax
+	orq	%rax, %rcx
+	leaq	5(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L141
+	movq	%r14, %r15
+	jmp	.L6
+.L141:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L142:
+#APP
+# 648 "runtime.c" 1
+	# OP(CLIT)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	addq	$8, %rbp
+	movsbq	(%rbx), %rcx
+	leaq	2(%rbx), %rax
+	movsbq	1(%rbx), %rsi
+	testq	%rsi, %rsi
+	jns	.L143
+	movq	%r14, %r15
+	jmp	.L6
+.L143:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L144:
+#APP
+# 653 "runtime.c" 1
+	# OP(PLIT)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rdx
+	addq	$8, %rbp
+	movzbl	1(%rbx), %eax
+	movsbq	2(%rbx), %rsi
+	salq	$8, %rdx
+	orq	%rdx, %rax
+	leaq	2(%rbx,%rax), %rcx
+	leaq	3(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L145
+	movq	%r14, %r15
+	jmp	.L6
+.L145:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L146:
+#APP
+# 660 "runtime.c" 1
+	# OP(SLIT)
+# 0 "" 2
+#NO_APP
+	movb	(%rbx), %al
+	leaq	1(%rbx), %rdx
+	movq	%rcx, 8(%rbp)
+	addq	$8, %rbp
+	movslq	%edx, %rcx
+	movsbl	%al, %eax
+	addq	%rax, %rdx
+	movsbq	(%rdx), %rsi
+	leaq	1(%rdx), %rax
+	testq	%rsi, %rsi
+	jns	.L147
+	movq	%r14, %r15
+	jmp	.L6
+.L147:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L148:
+#APP
+# 667 "runtime.c" 1
+	# OP(DEPTH)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	addq	$8, %rbp
+	subq	48(%r13), %rax
+	movq	%rcx, 0(%rbp)
+	movsbq	(%rbx), %rsi
+	sarq	$3, %rax
+	movslq	%eax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L149
+	movq	%r14, %r15
+	jmp	.L6
+.L149:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L150:
+#APP
+# 673 "runtime.c" 1
+	# OP(DROP)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L151
+	movq	%r14, %r15
+	jmp	.L6
+.L151:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L152:
+#APP
+# 677 "runtime.c" 1
+	# OP(NIP)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	subq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L153
+	movq	%r14, %r15
+	jmp	.L6
+.L153:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L154:
+#APP
+# 681 "runtime.c" 1
+	# OP(EMPTY)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	movq	48(%r13), %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L155
+	movq	%r14, %r15
+	jmp	.L6
+.L155:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L156:
+#APP
+# 685 "runtime.c" 1
+	# OP(DUP)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L157
+	movq	%r14, %r15
+	jmp	.L6
+.L157:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L158:
+#APP
+# 689 "runtime.c" 1
+	# OP(DUPNZ)
+# 0 "" 2
+#NO_APP
+	testq	%rcx, %rcx
+	je	.L159
+	movq	%rcx, 8(%rbp)
+	addq	$8, %rbp
+.L159:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L160
+	movq	%r14, %r15
+	jmp	.L6
+.L160:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L161:
+#APP
+# 694 "runtime.c" 1
+	# OP(OVER)
+# 0 "" 2
+#NO_APP
+	movq	0(%rbp), %rax
+	addq	$8, %rbp
+	movq	%rcx, 0(%rbp)
+	movsbq	(%rbx), %rsi
+	movslq	%eax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L162
+	movq	%r14, %r15
+	jmp	.L6
+.L162:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L163:
+#APP
+# 700 "runtime.c" 1
+	# OP(TUCK)
+# 0 "" 2
+#NO_APP
+	movq	0(%rbp), %rax
+	movq	%rcx, 0(%rbp)
+	addq	$8, %rbp
+	cltq
+	movq	%rax, 0(%rbp)
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L164
+	movq	%r14, %r15
+	jmp	.L6
+.L164:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L165:
+#APP
+# 706 "runtime.c" 1
+	# OP(PICK)
+# 0 "" 2
+#NO_APP
+	salq	$3, %rcx
+	movq	%rbp, %rax
+	movsbq	(%rbx), %rsi
+	subq	%rcx, %rax
+	movq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L166
+	movq	%r14, %r15
+	jmp	.L6
+.L166:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L167:
+#APP
+# 710 "runtime.c" 1
+	# OP(SWAP)
+# 0 "" 2
+#NO_APP
+	movslq	%ecx, %rax
+	movq	0(%rbp), %rcx
+	movq	%rax, 0(%rbp)
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L168
+	movq	%r14, %r15
+	jmp	.L6
+.L168:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L169:
+#APP
+# 716 "runtime.c" 1
+	# OP(ROT)
+# 0 "" 2
+#NO_APP
+	movq	0(%rbp), %rdx
+	movslq	%ecx, %rax
+	movq	-8(%rbp), %rcx
+	movq	%rax, 0(%rbp)
+	leaq	1(%rbx), %rax
+	movq	%rdx, -8(%rbp)
+	movsbq	(%rbx), %rsi
+	testq	%rsi, %rsi
+	jns	.L170
+	movq	%r14, %r15
+	jmp	.L6
+.L170:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L171:
+#APP
+# 723 "runtime.c" 1
+	# OP(TOR)
+# 0 "" 2
+#NO_APP
+	movq	-8(%rbp), %rdx
+	movslq	%ecx, %rax
+	movq	0(%rbp), %rcx
+	movq	%rax, -8(%rbp)
+	leaq	1(%rbx), %rax
+	movq	%rdx, 0(%rbp)
+	movsbq	(%rbx), %rsi
+	testq	%rsi, %rsi
+	jns	.L172
+	movq	%r14, %r15
+	jmp	.L6
+.L172:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L173:
+#APP
+# 730 "runtime.c" 1
+	# OP(ROLL)
+# 0 "" 2
+#NO_APP
+	testq	%rcx, %rcx
+	jg	.L174
+.L176:
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L175
+	movq	%r14, %r15
+	jmp	.L6
+.L174:
+	imulq	$-8, %rcx, %rcx
+	leaq	0(%rbp,%rcx), %rdi
+	movq	%rcx, %rdx
+	leaq	8(%rbp,%rcx), %rsi
+	movq	(%rdi), %rax
+	negq	%rdx
+	movq	%rax, 0(%rbp)
+	call	memmove@PLT
+	jmp	.L176
+.L175:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L177:
+#APP
+# 739 "runtime.c" 1
+	# OP(CELL)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L178
+	movq	%r14, %r15
+	movl	$8, %ecx
+	jmp	.L6
+.L178:
+	leaq	optab.1(%rip), %rdx
+	movl	$8, %ecx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L179:
+#APP
+# 744 "runtime.c" 1
+	# OP(CONSTN2)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L180
+	movq	%r14, %r15
+	movq	$-2, %rcx
+	jmp	.L6
+.L180:
+	leaq	optab.1(%rip), %rdx
+	movq	$-2, %rcx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L181:
+#APP
+# 749 "runtime.c" 1
+	# OP(CONSTN1)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L182
+	movq	%r14, %r15
+	orq	$-1, %rcx
+	jmp	.L6
+.L182:
+	leaq	optab.1(%rip), %rdx
+	orq	$-1, %rcx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L183:
+#APP
+# 754 "runtime.c" 1
+	# OP(CONST0)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L184
+	movq	%r14, %r15
+	xorl	%ecx, %ecx
+	jmp	.L6
+.L184:
+	leaq	optab.1(%rip), %rdx
+	xorl	%ecx, %ecx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L185:
+#APP
+# 759 "runtime.c" 1
+	# OP(CONST1)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L186
+	movq	%r14, %r15
+	movl	$1, %ecx
+	jmp	.L6
+.L186:
+	leaq	optab.1(%rip), %rdx
+	movl	$1, %ecx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L187:
+#APP
+# 764 "runtime.c" 1
+	# OP(CONST2)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L188
+	movq	%r14, %r15
+	movl	$2, %ecx
+	jmp	.L6
+.L188:
+	leaq	optab.1(%rip), %rdx
+	movl	$2, %ecx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L189:
+#APP
+# 769 "runtime.c" 1
+	# OP(CONST3)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L190
+	movq	%r14, %r15
+	movl	$3, %ecx
+	jmp	.L6
+.L190:
+	leaq	optab.1(%rip), %rdx
+	movl	$3, %ecx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L191:
+#APP
+# 774 "runtime.c" 1
+	# OP(TRUE)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L192
+	movq	%r14, %r15
+	orq	$-1, %rcx
+	jmp	.L6
+.L192:
+	leaq	optab.1(%rip), %rdx
+	orq	$-1, %rcx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L193:
+#APP
+# 779 "runtime.c" 1
+	# OP(FALSE)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L194
+	movq	%r14, %r15
+	xorl	%ecx, %ecx
+	jmp	.L6
+.L194:
+	leaq	optab.1(%rip), %rdx
+	xorl	%ecx, %ecx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L195:
+#APP
+# 784 "runtime.c" 1
+	# OP(NOT)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	notq	%rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L196
+	movq	%r14, %r15
+	jmp	.L6
+.L196:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L197:
+#APP
+# 788 "runtime.c" 1
+	# OP(AND)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	andq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L198
+	movq	%r14, %r15
+	jmp	.L6
+.L198:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L199:
+#APP
+# 792 "runtime.c" 1
+	# OP(OR)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	orq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L200
+	movq	%r14, %r15
+	jmp	.L6
+.L200:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L201:
+#APP
+# 796 "runtime.c" 1
+	# OP(XOR)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	xorq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L202
+	movq	%r14, %r15
+	jmp	.L6
+.L202:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L203:
+#APP
+# 800 "runtime.c" 1
+	# OP(NEG)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	negq	%rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L204
+	movq	%r14, %r15
+	jmp	.L6
+.L204:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L205:
+#APP
+# 804 "runtime.c" 1
+	# OP(INC)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	incq	%rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L206
+	movq	%r14, %r15
+	jmp	.L6
+.L206:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L207:
+#APP
+# 808 "runtime.c" 1
+	# OP(DEC)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	decq	%rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L208
+	movq	%r14, %r15
+	jmp	.L6
+.L208:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L209:
+#APP
+# 812 "runtime.c" 1
+	# OP(INC2)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	addq	$2, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L210
+	movq	%r14, %r15
+	jmp	.L6
+.L210:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L211:
+#APP
+# 816 "runtime.c" 1
+	# OP(DEC2)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	subq	$2, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L212
+	movq	%r14, %r15
+	jmp	.L6
+.L212:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L213:
+#APP
+# 820 "runtime.c" 1
+	# OP(MUL2)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	addq	%rcx, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L214
+	movq	%r14, %r15
+	jmp	.L6
+.L214:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L215:
+#APP
+# 824 "runtime.c" 1
+	# OP(DIV2)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	sarq	%rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L216
+	movq	%r14, %r15
+	jmp	.L6
+.L216:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L217:
+#APP
+# 828 "runtime.c" 1
+	# OP(ADD)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	addq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L218
+	movq	%r14, %r15
+	jmp	.L6
+.L218:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L219:
+#APP
+# 832 "runtime.c" 1
+	# OP(SUB)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	movsbq	(%rbx), %rsi
+	subq	$8, %rbp
+	movq	(%rax), %rax
+	subq	%rcx, %rax
+	movq	%rax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L220
+	movq	%r14, %r15
+	jmp	.L6
+.L220:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L221:
+#APP
+# 836 "runtime.c" 1
+	# OP(MUL)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	imulq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L222
+	movq	%r14, %r15
+	jmp	.L6
+.L222:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L223:
+#APP
+# 840 "runtime.c" 1
+	# OP(MULDIV)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	subq	$16, %rbp
+	imulq	-8(%rax), %rcx
+	movslq	(%rax), %rsi
+	movq	%rcx, %rax
+	cqto
+	idivq	%rsi
+	movsbq	(%rbx), %rsi
+	movq	%rax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L224
+	movq	%r14, %r15
+	jmp	.L6
+.L224:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L225:
+#APP
+# 845 "runtime.c" 1
+	# OP(DIV)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	movsbq	(%rbx), %rsi
+	subq	$8, %rbp
+	movq	(%rax), %rax
+	cqto
+	idivq	%rcx
+	movq	%rax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L226
+	movq	%r14, %r15
+	jmp	.L6
+.L226:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L227:
+#APP
+# 849 "runtime.c" 1
+	# OP(REM)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	movsbq	(%rbx), %rsi
+	subq	$8, %rbp
+	movq	(%rax), %rax
+	cqto
+	idivq	%rcx
+	leaq	1(%rbx), %rax
+	movq	%rdx, %rcx
+	testq	%rsi, %rsi
+	jns	.L228
+	movq	%r14, %r15
+	jmp	.L6
+.L228:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L229:
+#APP
+# 853 "runtime.c" 1
+	# OP(DIVREM)
+# 0 "" 2
+#NO_APP
+	movq	0(%rbp), %rax
+	cqto
+	idivq	%rcx
+	cltq
+	movq	%rdx, %rcx
+	movq	%rax, 0(%rbp)
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L230
+	movq	%r14, %r15
+	jmp	.L6
+.L230:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L231:
+#APP
+# 859 "runtime.c" 1
+	# OP(LSH)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	movsbq	(%rbx), %rsi
+	subq	$8, %rbp
+	movq	(%rax), %rax
+	salq	%cl, %rax
+	movq	%rax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L232
+	movq	%r14, %r15
+	jmp	.L6
+.L232:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L233:
+#APP
+# 863 "runtime.c" 1
+	# OP(RSH)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	movsbq	(%rbx), %rsi
+	subq	$8, %rbp
+	movq	(%rax), %rax
+	sarq	%cl, %rax
+	movq	%rax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L234
+	movq	%r14, %r15
+	jmp	.L6
+.L234:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L235:
+#APP
+# 867 "runtime.c" 1
+	# OP(ZNE)
+# 0 "" 2
+#NO_APP
+	negq	%rcx
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	sbbl	%ecx, %ecx
+	movslq	%ecx, %rcx
+	testq	%rsi, %rsi
+	jns	.L236
+	movq	%r14, %r15
+	jmp	.L6
+.L236:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L237:
+#APP
+# 871 "runtime.c" 1
+	# OP(ZLT)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	sarq	$63, %rcx
+	leaq	1(%rbx), %rax
+	movslq	%ecx, %rcx
+	testq	%rsi, %rsi
+	jns	.L238
+	movq	%r14, %r15
+	jmp	.L6
+.L238:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L239:
+#APP
+# 875 "runtime.c" 1
+	# OP(ZLE)
+# 0 "" 2
+#NO_APP
+	testq	%rcx, %rcx
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	setle	%cl
+	movzbl	%cl, %ecx
+	negl	%ecx
+	movslq	%ecx, %rcx
+	testq	%rsi, %rsi
+	jns	.L240
+	movq	%r14, %r15
+	jmp	.L6
+.L240:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L241:
+#APP
+# 879 "runtime.c" 1
+	# OP(ZEQ)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	cmpq	$1, %rcx
+	leaq	1(%rbx), %rax
+	sbbq	%rcx, %rcx
+	testq	%rsi, %rsi
+	jns	.L242
+	movq	%r14, %r15
+	jmp	.L6
+.L242:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L243:
+#APP
+# 883 "runtime.c" 1
+	# OP(ZGE)
+# 0 "" 2
+#NO_APP
+	notq	%rcx
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	sarq	$63, %rcx
+	movslq	%ecx, %rcx
+	testq	%rsi, %rsi
+	jns	.L244
+	movq	%r14, %r15
+	jmp	.L6
+.L244:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L245:
+#APP
+# 887 "runtime.c" 1
+	# OP(ZGT)
+# 0 "" 2
+#NO_APP
+	testq	%rcx, %rcx
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	setg	%cl
+	movzbl	%cl, %ecx
+	negl	%ecx
+	movslq	%ecx, %rcx
+	testq	%rsi, %rsi
+	jns	.L246
+	movq	%r14, %r15
+	jmp	.L6
+.L246:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L247:
+#APP
+# 891 "runtime.c" 1
+	# OP(NE)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movsbq	(%rbx), %rsi
+	cmpq	%rcx, (%rax)
+	leaq	1(%rbx), %rax
+	setne	%cl
+	movzbl	%cl, %ecx
+	negq	%rcx
+	testq	%rsi, %rsi
+	jns	.L248
+	movq	%r14, %r15
+	jmp	.L6
+.L248:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L249:
+#APP
+# 895 "runtime.c" 1
+	# OP(LT)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movsbq	(%rbx), %rsi
+	cmpq	%rcx, (%rax)
+	leaq	1(%rbx), %rax
+	setl	%cl
+	movzbl	%cl, %ecx
+	negl	%ecx
+	movslq	%ecx, %rcx
+	testq	%rsi, %rsi
+	jns	.L250
+	movq	%r14, %r15
+	jmp	.L6
+.L250:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L251:
+#APP
+# 899 "runtime.c" 1
+	# OP(LE)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movsbq	(%rbx), %rsi
+	cmpq	%rcx, (%rax)
+	leaq	1(%rbx), %rax
+	setle	%cl
+	movzbl	%cl, %ecx
+	negl	%ecx
+	movslq	%ecx, %rcx
+	testq	%rsi, %rsi
+	jns	.L252
+	movq	%r14, %r15
+	jmp	.L6
+.L252:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L253:
+#APP
+# 903 "runtime.c" 1
+	# OP(EQ)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movsbq	(%rbx), %rsi
+	cmpq	%rcx, (%rax)
+	leaq	1(%rbx), %rax
+	sete	%cl
+	movzbl	%cl, %ecx
+	negq	%rcx
+	testq	%rsi, %rsi
+	jns	.L254
+	movq	%r14, %r15
+	jmp	.L6
+.L254:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L255:
+#APP
+# 907 "runtime.c" 1
+	# OP(GE)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movsbq	(%rbx), %rsi
+	cmpq	%rcx, (%rax)
+	leaq	1(%rbx), %rax
+	setge	%cl
+	movzbl	%cl, %ecx
+	negl	%ecx
+	movslq	%ecx, %rcx
+	testq	%rsi, %rsi
+	jns	.L256
+	movq	%r14, %r15
+	jmp	.L6
+.L256:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L257:
+#APP
+# 911 "runtime.c" 1
+	# OP(GT)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movsbq	(%rbx), %rsi
+	cmpq	%rcx, (%rax)
+	leaq	1(%rbx), %rax
+	setg	%cl
+	movzbl	%cl, %ecx
+	negl	%ecx
+	movslq	%ecx, %rcx
+	testq	%rsi, %rsi
+	jns	.L258
+	movq	%r14, %r15
+	jmp	.L6
+.L258:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L259:
+#APP
+# 915 "runtime.c" 1
+	# OP(WITHIN)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %rdx
+	subq	$8, %rbp
+	movsbq	(%rbx), %rsi
+	movq	-8(%rdx), %rax
+	movslq	(%rdx), %rdx
+	cmpq	%rdx, %rax
+	setge	%dl
+	cmpq	%rcx, %rax
+	leaq	1(%rbx), %rax
+	setle	%cl
+	movzbl	%cl, %ecx
+	andl	%edx, %ecx
+	negl	%ecx
+	movslq	%ecx, %rcx
+	testq	%rsi, %rsi
+	jns	.L260
+	movq	%r14, %r15
+	jmp	.L6
+.L260:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L261:
+#APP
+# 920 "runtime.c" 1
+	# OP(ABS)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, %rax
+	movsbq	(%rbx), %rsi
+	sarq	$63, %rax
+	movslq	%eax, %rdx
+	movq	%rcx, %rax
+	negq	%rax
+	andq	%rax, %rdx
+	movq	%rcx, %rax
+	notq	%rax
+	sarq	$63, %rax
+	cltq
+	andq	%rcx, %rax
+	movq	%rdx, %rcx
+	orq	%rax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L262
+	movq	%r14, %r15
+	jmp	.L6
+.L262:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L263:
+#APP
+# 924 "runtime.c" 1
+	# OP(MIN)
+# 0 "" 2
+#NO_APP
+	movq	0(%rbp), %rdx
+	xorl	%eax, %eax
+	movsbq	(%rbx), %rsi
+	cmpq	%rcx, %rdx
+	setg	%al
+	negl	%eax
+	cltq
+	andq	%rcx, %rax
+	cmpq	%rcx, %rdx
+	setle	%cl
+	subq	$8, %rbp
+	movzbl	%cl, %ecx
+	negl	%ecx
+	movslq	%ecx, %rcx
+	andq	%rdx, %rcx
+	orq	%rax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L264
+	movq	%r14, %r15
+	jmp	.L6
+.L264:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L265:
+#APP
+# 929 "runtime.c" 1
+	# OP(MAX)
+# 0 "" 2
+#NO_APP
+	movq	0(%rbp), %rdx
+	xorl	%eax, %eax
+	movsbq	(%rbx), %rsi
+	cmpq	%rcx, %rdx
+	setl	%al
+	negl	%eax
+	cltq
+	andq	%rcx, %rax
+	cmpq	%rcx, %rdx
+	setge	%cl
+	subq	$8, %rbp
+	movzbl	%cl, %ecx
+	negl	%ecx
+	movslq	%ecx, %rcx
+	andq	%rdx, %rcx
+	orq	%rax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L266
+	movq	%r14, %r15
+	jmp	.L6
+.L266:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L267:
+	movq	%rcx, 24(%rsp)
+#APP
+# 934 "runtime.c" 1
+	# OP(DUMP)
+# 0 "" 2
+#NO_APP
+	movq	%rbp, %r15
+	subq	48(%r13), %r15
+	xorl	%eax, %eax
+	movq	stdout(%rip), %rdi
+	sarq	$3, %r15
+	leaq	.LC0(%rip), %rsi
+	movl	%r15d, %edx
+	movl	%r15d, 16(%rsp)
+	call	fprintf@PLT
+	testl	%r15d, %r15d
+	movq	24(%rsp), %rcx
+	jle	.L268
+	movq	48(%r13), %rax
+	leaq	8(%rax), %r15
+.L269:
+	decl	16(%rsp)
+	movq	stdout(%rip), %rdi
+	je	.L315
+	movl	8(%r15), %edx
+	xorl	%eax, %eax
+	movq	%rcx, 24(%rsp)
+	addq	$8, %r15
+	leaq	.LC1(%rip), %rsi
+	call	fprintf@PLT
+	movq	24(%rsp), %rcx
+	jmp	.L269
+.L315:
+	movl	%ecx, %edx
+	leaq	.LC2(%rip), %rsi
+	xorl	%eax, %eax
+	movq	%rcx, 16(%rsp)
+	call	fprintf@PLT
+	movq	16(%rsp), %rcx
+.L268:
+	movq	stdout(%rip), %rsi
+	movl	$10, %edi
+	movq	%rcx, 16(%rsp)
+	call	fputc@PLT
+	movsbq	(%rbx), %rsi
+	movq	16(%rsp), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L271
+	movq	%r14, %r15
+	jmp	.L6
+.L271:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L272:
+#APP
+# 950 "runtime.c" 1
+	# OP(PUTC)
+# 0 "" 2
+#NO_APP
+	movq	stdout(%rip), %rsi
+	movl	%ecx, %edi
+	call	putc@PLT
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L273
+	movq	%r14, %r15
+	jmp	.L6
+.L273:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L274:
+#APP
+# 955 "runtime.c" 1
+	# OP(PUTI)
+# 0 "" 2
+#NO_APP
+	movq	stdout(%rip), %rdi
+	movl	%ecx, %edx
+	leaq	.LC1(%rip), %rsi
+	xorl	%eax, %eax
+	call	fprintf@PLT
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L275
+	movq	%r14, %r15
+	jmp	.L6
+.L275:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L276:
+#APP
+# 960 "runtime.c" 1
+	# OP(PUTX)
+# 0 "" 2
+#NO_APP
+	movq	stdout(%rip), %rdi
+	movl	%ecx, %edx
+	leaq	.LC3(%rip), %rsi
+	xorl	%eax, %eax
+	call	fprintf@PLT
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L277
+	movq	%r14, %r15
+	jmp	.L6
+.L277:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L278:
+#APP
+# 965 "runtime.c" 1
+	# OP(PUTS)
+# 0 "" 2
+#NO_APP
+	movq	stdout(%rip), %rsi
+	movq	%rcx, %rdi
+	call	fputs@PLT
+	movsbq	(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L279
+	movq	%r14, %r15
+	jmp	.L6
+.L279:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L280:
+	movq	%rcx, 16(%rsp)
+#APP
+# 970 "runtime.c" 1
+	# OP(CR)
+# 0 "" 2
+#NO_APP
+	movq	stdout(%rip), %rsi
+	movl	$10, %edi
+	call	putc@PLT
+	movsbq	(%rbx), %rsi
+	movq	16(%rsp), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L281
+	movq	%r14, %r15
+	jmp	.L6
+.L281:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L282:
+#APP
+# 974 "runtime.c" 1
+	# OP(GETC)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movq	stdin(%rip), %rdi
+	addq	$8, %rbp
+	call	getc@PLT
+	movsbq	(%rbx), %rsi
+	movslq	%eax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L283
+	movq	%r14, %r15
+	jmp	.L6
+.L283:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L284:
+#APP
+# 979 "runtime.c" 1
+	# OP(GETS)
+# 0 "" 2
+#NO_APP
+	movq	stdin(%rip), %rdx
+	movq	-8(%rbp), %rdi
+	movl	%ecx, %esi
+	subq	$8, %rbp
+	call	fgets@PLT
+	movsbq	(%rbx), %rsi
+	movslq	%eax, %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L285
+	movq	%r14, %r15
+	jmp	.L6
+.L285:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L286:
+#APP
+# 983 "runtime.c" 1
+	# OP(VERSION)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	movq	16(%r12), %rcx
+	testq	%rsi, %rsi
+	jns	.L287
+	movq	%r14, %r15
+	jmp	.L6
+.L287:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L288:
+#APP
+# 988 "runtime.c" 1
+	# OP(IDENT)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%rbp)
+	movsbq	(%rbx), %rsi
+	addq	$8, %rbp
+	leaq	1(%rbx), %rax
+	movq	8(%r12), %rcx
+	testq	%rsi, %rsi
+	jns	.L289
+	movq	%r14, %r15
+	jmp	.L6
+.L289:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L23:
+#APP
+# 993 "runtime.c" 1
+	# OP(HALT)
+# 0 "" 2
+#NO_APP
+	lock decl	vfm_tasks(%rip)
+	cmpq	%rbp, 48(%r13)
+	je	.L290
+	movq	%rcx, 8(%rbp)
+	addq	$8, %rbp
+.L290:
+	movq	8(%rsp), %rax
+	movq	%rbp, 16(%r13)
+	movq	%rbx, 24(%r13)
+	movq	%rax, 32(%r13)
+	movl	0(%r13), %eax
+	movq	%r14, 40(%r13)
+	sarl	$4, %eax
+	movq	%r12, 8(%r13)
+	andl	$1, %eax
+	jmp	.L1
+.L291:
+#APP
+# 1008 "runtime.c" 1
+	# OP(OVER_EQ_BRZE)
+# 0 "" 2
+#NO_APP
+	xorl	%eax, %eax
+	cmpq	%rcx, 0(%rbp)
+	movsbq	(%rbx), %rdx
+	setne	%al
+	negq	%rax
+	andq	%rdx, %rax
+	leaq	1(%rbx,%rax), %rbx
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	testq	%rdx, %rdx
+	jns	.L292
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L292
+	movq	%r14, %r15
+	jmp	.L5
+.L292:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L293
+	movq	%r14, %r15
+	jmp	.L6
+.L293:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L294:
+#APP
+# 1015 "runtime.c" 1
+	# OP(DUP_BRZE)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rdx
+	cmpq	$1, %rcx
+	sbbq	%rax, %rax
+	andq	%rdx, %rax
+	leaq	1(%rbx,%rax), %rbx
+	testq	%rdx, %rdx
+	jns	.L295
+	movl	vfm_request(%rip), %eax
+	testl	%eax, %eax
+	je	.L295
+	movq	%r14, %r15
+	jmp	.L5
+.L295:
+	movsbq	(%rbx), %rsi
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L296
+	movq	%r14, %r15
+	jmp	.L6
+.L296:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L297:
+#APP
+# 1021 "runtime.c" 1
+	# OP(CLIT_ADD)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rax
+	movsbq	1(%rbx), %rsi
+	addq	%rax, %rcx
+	leaq	2(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L298
+	movq	%r14, %r15
+	jmp	.L6
+.L298:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L299:
+#APP
+# 1025 "runtime.c" 1
+	# OP(LIT_STORE)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rax
+	movzbl	1(%rbx), %edx
+	salq	$8, %rax
+	orq	%rax, %rdx
+	movzbl	2(%rbx), %eax
+	salq	$8, %rdx
+	orq	%rdx, %rax
+	movzbl	3(%rbx), %edx
+	salq	$8, %rax
+	orq	%rdx, %rax
+	movq	%rcx, (%rax)
+	movsbq	4(%rbx), %rsi
+	movq	%rbp, %rax
+	subq	$8, %rbp
+	movq	(%rax), %rcx
+	leaq	5(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L300
+	movq	%r14, %r15
+	jmp	.L6
+.L300:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L301:
+#APP
+# 1034 "runtime.c" 1
+	# OP(RPUSH_RPUSH)
+# 0 "" 2
+#NO_APP
+	movq	%rcx, 8(%r14)
+	movq	0(%rbp), %rcx
+	movq	%rbp, %rax
+	leaq	8(%r14), %rdx
+	subq	$16, %rbp
+	addq	$16, %r14
+	movq	%rcx, 8(%rdx)
+	movsbq	(%rbx), %rsi
+	movq	-8(%rax), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L302
+	movq	%r14, %r15
+	jmp	.L6
+.L302:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L303:
+#APP
+# 1040 "runtime.c" 1
+	# OP(RCOPY_ADD)
+# 0 "" 2
+#NO_APP
+	movsbq	(%rbx), %rsi
+	addq	(%r14), %rcx
+	leaq	1(%rbx), %rax
+	testq	%rsi, %rsi
+	jns	.L304
+	movq	%r14, %r15
+	jmp	.L6
+.L304:
+	leaq	optab.1(%rip), %rdx
+	movq	(%rdx,%rsi,8), %rdx
+	jmp	.L10
+.L46:
+	movq	(%r15), %rax
+	leaq	-8(%r15), %rdx
+	subq	$2, %rbx
+	lock decl	vfm_tasks(%rip)
+	cmpq	%rbp, 48(%r13)
+	je	.L305
+	movq	%rcx, 8(%rbp)
+	addq	$8, %rbp
+.L305:
+	movq	8(%rsp), %rdi
+	movq	%rbp, 16(%r13)
+	movq	%rbx, 24(%r13)
+	movq	%rdx, 40(%r13)
+	movq	%rdi, 32(%r13)
+	movq	%rax, 8(%r13)
+	movl	%fs:vfm_errno@tpoff, %eax
+.L1:
+	addq	$40, %rsp
+	.cfi_def_cfa_offset 56
+	popq	%rbx
+	.cfi_def_cfa_offset 48
+	popq	%rbp
+	.cfi_def_cfa_offset 40
+	popq	%r12
+	.cfi_def_cfa_offset 32
+	popq	%r13
+	.cfi_def_cfa_offset 24
+	popq	%r14
+	.cfi_def_cfa_offset 16
+	popq	%r15
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+.LFE2:
+	.size	vfm_run_fast, .-vfm_run_fast
+	.globl	vfm_init
+	.type	vfm_init, @function
+vfm_init:
+.LFB0:
+	.cfi_startproc
+	xorl	%edi, %edi
+	jmp	vfm_run_fast
+	.cfi_endproc
+.LFE0:
+	.size	vfm_init, .-vfm_init
+	.globl	vfm_run
+	.type	vfm_run, @function
+vfm_run:
+.LFB1:
+	.cfi_startproc
+	testq	%rdi, %rdi
+	jne	.L323
+	xorl	%eax, %eax
+	jmp	vfm_init
+.L323:
+	pushq	%rbx
+	.cfi_def_cfa_offset 16
+	.cfi_offset 3, -16
+	movq	%rdi, %rbx
+.L318:
+	testb	$3, (%rbx)
+	je	.L319
+	movq	%rbx, %rdi
+	call	vfm_run_instrumented@PLT
+	jmp	.L320
+.L319:
+	movq	%rbx, %rdi
+	call	vfm_run_fast
+.L320:
+	cmpl	$1, %eax
+	je	.L318
+	popq	%rbx
+	.cfi_def_cfa_offset 8
+	ret
+	.cfi_endproc
+.LFE1:
+	.size	vfm_run, .-vfm_run
+	.section	.rodata.str1.1
+.LC4:
+	.string	"EXT0"
+.LC5:
+	.string	"EXT1"
+.LC6:
+	.string	"EXT2"
+.LC7:
+	.string	"EXT3"
+.LC8:
+	.string	"NEXT"
+.LC9:
+	.string	"TRACING"
+.LC10:
+	.string	"PROFILING"
+.LC11:
+	.string	"NEST"
+.LC12:
+	.string	"NNEST"
+.LC13:
+	.string	"UNNEST"
+.LC14:
+	.string	"UNNEZE"
+.LC15:
+	.string	"MEST"
+.LC16:
+	.string	"MESTI"
+.LC17:
+	.string	"UNMEST"
+.LC18:
+	.string	"UNMEZT"
+.LC19:
+	.string	"UNSLIT"
+.LC20:
+	.string	"UNLIT"
+.LC21:
+	.string	"BRA"
+.LC22:
+	.string	"BRAX"
+.LC23:
+	.string	"BRZX"
+.LC24:
+	.string	"BRZE"
+.LC25:
+	.string	"BRZN"
+.LC26:
+	.string	"DBZN"
+.LC27:
+	.string	"RBZN"
+.LC28:
+	.string	"RDBG"
+.LC29:
+	.string	"RBRI"
+.LC30:
+	.string	"RBNE"
+.LC31:
+	.string	"RDNE"
+.LC32:
+	.string	"TASK"
+.LC33:
+	.string	"LOCAL"
+.LC34:
+	.string	"HERE"
+.LC35:
+	.string	"ALLOT"
+.LC36:
+	.string	"TRACE"
+.LC37:
+	.string	"PROFILE"
+.LC38:
+	.string	"EXEC"
+.LC39:
+	.string	"CLOAD"
+.LC40:
+	.string	"CSTORE"
+.LC41:
+	.string	"LOAD"
+.LC42:
+	.string	"STORE"
+.LC43:
+	.string	"ICLOAD"
+.LC44:
+	.string	"ICSTORE"
+.LC45:
+	.string	"ILOAD"
+.LC46:
+	.string	"ISTORE"
+.LC47:
+	.string	"RPUSH"
+.LC48:
+	.string	"RDUP"
+.LC49:
+	.string	"RPOP"
+.LC50:
+	.string	"RCOPY"
+.LC51:
+	.string	"LIT"
+.LC52:
+	.string	"CLIT"
+.LC53:
+	.string	"PLIT"
+.LC54:
+	.string	"SLIT"
+.LC55:
+	.string	"DEPTH"
+.LC56:
+	.string	"DROP"
+.LC57:
+	.string	"NIP"
+.LC58:
+	.string	"EMPTY"
+.LC59:
+	.string	"DUP"
+.LC60:
+	.string	"DUPNZ"
+.LC61:
+	.string	"OVER"
+.LC62:
+	.string	"TUCK"
+.LC63:
+	.string	"PICK"
+.LC64:
+	.string	"SWAP"
+.LC65:
+	.string	"ROT"
+.LC66:
+	.string	"TOR"
+.LC67:
+	.string	"ROLL"
+.LC68:
+	.string	"CELL"
+.LC69:
+	.string	"CONSTN2"
+.LC70:
+	.string	"CONSTN1"
+.LC71:
+	.string	"CONST0"
+.LC72:
+	.string	"CONST1"
+.LC73:
+	.string	"CONST2"
+.LC74:
+	.string	"CONST3"
+.LC75:
+	.string	"TRUE"
+.LC76:
+	.string	"FALSE"
+.LC77:
+	.string	"NOT"
+.LC78:
+	.string	"AND"
+.LC79:
+	.string	"OR"
+.LC80:
+	.string	"XOR"
+.LC81:
+	.string	"NEG"
+.LC82:
+	.string	"INC"
+.LC83:
+	.string	"DEC"
+.LC84:
+	.string	"INC2"
+.LC85:
+	.string	"DEC2"
+.LC86:
+	.string	"MUL2"
+.LC87:
+	.string	"DIV2"
+.LC88:
+	.string	"ADD"
+.LC89:
+	.string	"SUB"
+.LC90:
+	.string	"MUL"
+.LC91:
+	.string	"MULDIV"
+.LC92:
+	.string	"DIV"
+.LC93:
+	.string	"REM"
+.LC94:
+	.string	"DIVREM"
+.LC95:
+	.string	"LSH"
+.LC96:
+	.string	"RSH"
+.LC97:
+	.string	"ZNE"
+.LC98:
+	.string	"ZLT"
+.LC99:
+	.string	"ZLE"
+.LC100:
+	.string	"ZEQ"
+.LC101:
+	.string	"ZGE"
+.LC102:
+	.string	"ZGT"
+.LC103:
+	.string	"NE"
+.LC104:
+	.string	"LT"
+.LC105:
+	.string	"LE"
+.LC106:
+	.string	"EQ"
+.LC107:
+	.string	"GE"
+.LC108:
+	.string	"GT"
+.LC109:
+	.string	"WITHIN"
+.LC110:
+	.string	"ABS"
+.LC111:
+	.string	"MIN"
+.LC112:
+	.string	"MAX"
+.LC113:
+	.string	"DUMP"
+.LC114:
+	.string	"PUTC"
+.LC115:
+	.string	"PUTI"
+.LC116:
+	.string	"PUTX"
+.LC117:
+	.string	"PUTS"
+.LC118:
+	.string	"CR"
+.LC119:
+	.string	"GETC"
+.LC120:
+	.string	"GETS"
+.LC121:
+	.string	"VERSION"
+.LC122:
+	.string	"IDENT"
+.LC123:
+	.string	"HALT"
+.LC124:
+	.string	"OVER_EQ_BRZE"
+.LC125:
+	.string	"DUP_BRZE"
+.LC126:
+	.string	"CLIT_ADD"
+.LC127:
+	.string	"LIT_STORE"
+.LC128:
+	.string	"RPUSH_RPUSH"
+.LC129:
+	.string	"RCOPY_ADD"
+	.section	.data.rel.local,"aw"
+	.align 32
+	.type	opname.0, @object
+	.size	opname.0, 8192
+opname.0:
+	.quad	.LC4
+	.quad	.LC5
+	.quad	.LC6
+	.quad	.LC7
+	.quad	.LC8
+	.quad	.LC9
+	.quad	.LC10
+	.quad	.LC11
+	.quad	.LC12
+	.quad	.LC13
+	.quad	.LC14
+	.quad	.LC15
+	.quad	.LC16
+	.quad	.LC17
+	.quad	.LC18
+	.quad	.LC19
+	.quad	.LC20
+	.quad	.LC21
+	.quad	.LC22
+	.quad	.LC23
+	.quad	.LC24
+	.quad	.LC25
+	.quad	.LC26
+	.quad	.LC27
+	.quad	.LC28
+	.quad	.LC29
+	.quad	.LC30
+	.quad	.LC31
+	.quad	.LC32
+	.quad	.LC33
+	.quad	.LC34
+	.quad	.LC35
+	.quad	.LC36
+	.quad	.LC37
+	.quad	.LC38
+	.quad	.LC39
+	.quad	.LC40
+	.quad	.LC41
+	.quad	.LC42
+	.quad	.LC43
+	.quad	.LC44
+	.quad	.LC45
+	.quad	.LC46
+	.quad	.LC47
+	.quad	.LC48
+	.quad	.LC49
+	.quad	.LC50
+	.quad	.LC51
+	.quad	.LC52
+	.quad	.LC53
+	.quad	.LC54
+	.quad	.LC55
+	.quad	.LC56
+	.quad	.LC57
+	.quad	.LC58
+	.quad	.LC59
+	.quad	.LC60
+	.quad	.LC61
+	.quad	.LC62
+	.quad	.LC63
+	.quad	.LC64
+	.quad	.LC65
+	.quad	.LC66
+	.quad	.LC67
+	.quad	.LC68
+	.quad	.LC69
+	.quad	.LC70
+	.quad	.LC71
+	.quad	.LC72
+	.quad	.LC73
+	.quad	.LC74
+	.quad	.LC75
+	.quad	.LC76
+	.quad	.LC77
+	.quad	.LC78
+	.quad	.LC79
+	.quad	.LC80
+	.quad	.LC81
+	.quad	.LC82
+	.quad	.LC83
+	.quad	.LC84
+	.quad	.LC85
+	.quad	.LC86
+	.quad	.LC87
+	.quad	.LC88
+	.quad	.LC89
+	.quad	.LC90
+	.quad	.LC91
+	.quad	.LC92
+	.quad	.LC93
+	.quad	.LC94
+	.quad	.LC95
+	.quad	.LC96
+	.quad	.LC97
+	.quad	.LC98
+	.quad	.LC99
+	.quad	.LC100
+	.quad	.LC101
+	.quad	.LC102
+	.quad	.LC103
+	.quad	.LC104
+	.quad	.LC105
+	.quad	.LC106
+	.quad	.LC107
+	.quad	.LC108
+	.quad	.LC109
+	.quad	.LC110
+	.quad	.LC111
+	.quad	.LC112
+	.quad	.LC113
+	.quad	.LC114
+	.quad	.LC115
+	.quad	.LC116
+	.quad	.LC117
+	.quad	.LC118
+	.quad	.LC119
+	.quad	.LC120
+	.quad	.LC121
+	.quad	.LC122
+	.quad	.LC123
+	.quad	.LC124
+	.quad	.LC125
+	.quad	.LC126
+	.quad	.LC127
+	.quad	.LC128
+	.quad	.LC129
+	.quad	0
+	.zero	7176
+	.align 32
+	.type	optab.1, @object
+	.size	optab.1, 8192
+optab.1:
+	.quad	.L8
+	.quad	.L9
+	.quad	.L11
+	.quad	.L12
+	.quad	.L13
+	.quad	.L24
+	.quad	.L25
+	.quad	.L26
+	.quad	.L28
+	.quad	.L31
+	.quad	.L33
+	.quad	.L36
+	.quad	.L42
+	.quad	.L48
+	.quad	.L50
+	.quad	.L52
+	.quad	.L54
+	.quad	.L56
+	.quad	.L59
+	.quad	.L62
+	.quad	.L65
+	.quad	.L68
+	.quad	.L71
+	.quad	.L76
+	.quad	.L81
+	.quad	.L86
+	.quad	.L90
+	.quad	.L95
+	.quad	.L100
+	.quad	.L102
+	.quad	.L104
+	.quad	.L106
+	.quad	.L108
+	.quad	.L111
+	.quad	.L114
+	.quad	.L116
+	.quad	.L118
+	.quad	.L120
+	.quad	.L122
+	.quad	.L124
+	.quad	.L126
+	.quad	.L128
+	.quad	.L130
+	.quad	.L132
+	.quad	.L134
+	.quad	.L136
+	.quad	.L138
+	.quad	.L140
+	.quad	.L142
+	.quad	.L144
+	.quad	.L146
+	.quad	.L148
+	.quad	.L150
+	.quad	.L152
+	.quad	.L154
+	.quad	.L156
+	.quad	.L158
+	.quad	.L161
+	.quad	.L163
+	.quad	.L165
+	.quad	.L167
+	.quad	.L169
+	.quad	.L171
+	.quad	.L173
+	.quad	.L177
+	.quad	.L179
+	.quad	.L181
+	.quad	.L183
+	.quad	.L185
+	.quad	.L187
+	.quad	.L189
+	.quad	.L191
+	.quad	.L193
+	.quad	.L195
+	.quad	.L197
+	.quad	.L199
+	.quad	.L201
+	.quad	.L203
+	.quad	.L205
+	.quad	.L207
+	.quad	.L209
+	.quad	.L211
+	.quad	.L213
+	.quad	.L215
+	.quad	.L217
+	.quad	.L219
+	.quad	.L221
+	.quad	.L223
+	.quad	.L225
+	.quad	.L227
+	.quad	.L229
+	.quad	.L231
+	.quad	.L233
+	.quad	.L235
+	.quad	.L237
+	.quad	.L239
+	.quad	.L241
+	.quad	.L243
+	.quad	.L245
+	.quad	.L247
+	.quad	.L249
+	.quad	.L251
+	.quad	.L253
+	.quad	.L255
+	.quad	.L257
+	.quad	.L259
+	.quad	.L261
+	.quad	.L263
+	.quad	.L265
+	.quad	.L267
+	.quad	.L272
+	.quad	.L274
+	.quad	.L276
+	.quad	.L278
+	.quad	.L280
+	.quad	.L282
+	.quad	.L284
+	.quad	.L286
+	.quad	.L288
+	.quad	.L23
+	.quad	.L291
+	.quad	.L294
+	.quad	.L297
+	.quad	.L299
+	.quad	.L301
+	.quad	.L303
+	.quad	0
+	.zero	7176
+	.globl	vfm_tasks
+	.bss
+	.align 4
+	.type	vfm_tasks, @object
+	.size	vfm_tasks, 4
+vfm_tasks:
+	.zero	4
+	.globl	vfm_request
+	.align 4
+	.type	vfm_request, @object
+	.size	vfm_request, 4
+vfm_request:
+	.zero	4
+	.globl	vfm_oprefcnt
+	.align 32
+	.type	vfm_oprefcnt, @object
+	.size	vfm_oprefcnt, 8192
+vfm_oprefcnt:
+	.zero	8192
+	.globl	vfm_opname
+	.align 8
+	.type	vfm_opname, @object
+	.size	vfm_opname, 8
+vfm_opname:
+	.zero	8
+	.globl	vfm_optab
+	.align 8
+	.type	vfm_optab, @object
+	.size	vfm_optab, 8
+vfm_optab:
+	.zero	8
+	.globl	vfm_errno
+	.section	.tbss,"awT",@nobits
+	.align 4
+	.type	vfm_errno, @object
+	.size	vfm_errno, 4
+vfm_errno:
+	.zero	4
+	.ident	"GCC: (Debian 12.2.0-14+deb12u1) 12.2.0"
+	.section	.note.GNU-stack,"",@progbits
@@ -0,0 +1,92 @@
+# NB: Generate specialized inner interpreter (special.c) from runtime.c.
+# NB: First input is the operation usage list (vfa -o), most used first.
+# NB: With a profile (makefile SPECIAL_PROFILE) the dispatched operations
+# NB: are listed first by dispatch count (vfprof) and then the static list.
+# NB: Operation bodies are written in that order; NEXT first and HALT
+# NB: last. Operation table entries for unused operations are TRAP;
+# NB: the full extension range is only kept when extensions are used.
+# NB: Labels after HALT and the operations (SWITCH, UNRESOLVED, TRAP)
+# NB: are the epilogue and written last. Comments after HALT are kept
+# NB: with the operation or label that follows.
+
+FNR == NR {
+  if (!($2 in used)) order[++nr_used] = $2;
+  used[$2] = 1;
+  next
+}
+
+/^OP\(/ {
+  name = $0;
+  sub(/^OP\(/, "", name);
+  sub(/\).*/, "", name);
+  ops[++nr_ops] = name;
+  op = name;
+  if (halt) body[op] = pending;
+  if (name == "HALT") halt = 1;
+  pending = "";
+}
+
+/^ [A-Z_]+:/ && halt {
+  n = split(pending, line, "\n") - 1;
+  for (i = 1; i <= n; i++)
+    epilogue[++nr_tail] = line[i];
+  op = "";
+  tail = 1;
+  pending = "";
+}
+
+halt && op != "" && /^(\/\/.*)?$/ {
+  pending = pending $0 "\n";
+  next
+}
+
+op == "" && tail {
+  epilogue[++nr_tail] = $0;
+  next
+}
+
+op == "" {
+  prologue[++nr_lines] = $0;
+  next
+}
+
+{
+  body[op] = body[op] pending $0 "\n";
+  pending = "";
+}
+
+function tables(i, ext) {
+  print "// NB: Operation names and jump table generated by makefile (special.awk)";
+  print "";
+  print "static char* opname[VFM_OPMAX + 1] = {";
+  for (i = 1; i <= nr_ops; i++)
+    print " \"" ops[i] "\",";
+  print " 0";
+  print "};";
+  print "";
+  ext = ("EXT0" in used || "EXT1" in used || "EXT2" in used || "EXT3" in used);
+  print "static void* optab[" (ext ? "VFM_OPMAX + 1" : "VFM_OP_LAST + 1") "] = {";
+  for (i = 1; i <= nr_ops; i++)
+    print " &&" ((ops[i] in used || ops[i] == "NEXT" || ops[i] == "HALT") ? ops[i] : "TRAP") ",";
+  if (ext) print " [VFM_OP_LAST + 1 ... VFM_OPMAX] = &&TRAP";
+  print "};";
+}
+
+END {
+  print "// NB: Specialized inner interpreter generated by makefile (special.awk)";
+  print "";
+  print "#define VFM_SPECIAL_ENGINE";
+  for (i = 1; i <= nr_lines; i++) {
+    if (prologue[i] ~ /^#include "optab.i"/)
+      tables();
+    else
+      print prologue[i];
+  }
+  printf "%s", body["NEXT"];
+  for (i = 1; i <= nr_used; i++)
+    if (order[i] != "NEXT" && order[i] != "HALT" && (order[i] in body))
+      printf "%s", body[order[i]];
+  printf "%s", body["HALT"];
+  for (i = 1; i <= nr_tail; i++)
+    print epilogue[i];
+}
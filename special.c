@@ -0,0 +1,984 @@
+// NB: Specialized inner interpreter generated by makefile (special.awk)
+
+#define VFM_SPECIAL_ENGINE
+/* Copyright 2009, Mikael Patel
+   This file is part of vfm, virtual forth machine project.
+ 
+   vfm is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+ 
+   vfm is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+ 
+   You should have received a copy of the GNU General Public License
+   along with vfm.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include "vfm.h"
+#include <string.h>
+
+// NB: The inner interpreter is compiled twice (makefile); a fast engine
+// NB: with inline next and an instrumented engine with pointer to next
+// NB: for tracing and profiling. The engines switch on status change.
+
+#if defined(VFM_INSTRUMENTED_ENGINE)
+# define VFM_USE_NEXT_POINTER
+# define VFM_RUN vfm_run_instrumented
+#else
+# define VFM_USE_INLINE_NEXT
+# define VFM_RUN vfm_run_fast
+#endif
+
+#if defined(VFM_USE_NEXT_POINTER)
+# define NEXT() goto *np
+#elif defined(VFM_USE_INLINE_NEXT)
+# define NEXT() if ((ir = *ip++) >= 0) goto *optab[ir]; goto NEXT0
+#else 
+# define NEXT() goto NEXT
+#endif
+
+// NB: External requests are polled on backward branches (negative
+// NB: offset) so that loops without calls are also interrupted
+
+#define POLL(offset) if ((offset) < 0 && vfm_request) goto REQUEST
+
+// NB: Assembly list operation hint. The comment on an operation line
+// NB: is the source word and stack effect; used to generate the
+// NB: operation micro-benchmarks (opbench.awk). A trailing [n] is the
+// NB: number of inline operand bytes, [-1] when variable length; used
+// NB: to generate the operand size table (opsize.i, vfm_opsize).
+
+#define OP(n) n: asm("# OP(" # n ")"); 
+
+#if !defined(VFM_INSTRUMENTED_ENGINE)
+__thread int vfm_errno = 0;
+void* vfm_optab = 0;
+char** vfm_opname = 0;
+long long vfm_oprefcnt[VFM_OPMAX + 1] = { 0 };
+volatile int vfm_request = 0;
+volatile int vfm_tasks = 0;
+#endif
+
+// Utility functions
+
+#if defined(VFM_USE_NEXT_POINTER)
+static vfm_symb_t* inc_refcnt(vfm_code_t *cp, vfm_dict_t* dict)
+{
+  vfm_symb_t* symb = vfm_addr2symb(cp, dict);
+  if (symb)
+    symb->refcnt += 1;
+  return (symb);
+}
+
+static void inc_opcnt(vfm_code_t *cp, vfm_mod_t* mp)
+{
+  unsigned offset = cp - mp->segment.code;
+  long long* refcnt = (mp->segment.refcnt ? mp->segment.refcnt : vfm_counters(mp));
+  if (refcnt && offset < (unsigned) mp->segment.size)
+    refcnt[offset] += 1;
+}
+
+static void ftrace(FILE* file, int depth, vfm_code_t* cp, vfm_mod_t* mp)
+{
+  vfm_symb_t* symb = vfm_addr2symb(cp, &mp->dict);
+  fprintf(file, "R[%d] %s::", depth, mp->name);
+  if (symb){
+    symb->refcnt += 1;
+    fprintf(file, "%s@", symb->name);
+  }
+  fprintf(file, "%p", cp);
+}
+#endif
+
+#if !defined(VFM_INSTRUMENTED_ENGINE)
+
+// TODO: Get this done automatically before main if possible
+
+int vfm_init()
+{
+  return (vfm_run_fast(0));
+}
+
+// NB: Run environment in engine given by status; tracing and profiling
+// NB: in the instrumented engine. Continue in the other engine on switch
+
+int vfm_run(vfm_env_t* env) 
+{
+  int res;
+
+  if (!env) return (vfm_init());
+  do {
+    if (env->status & VFM_INSTRUMENTED_STATUS)
+      res = vfm_run_instrumented(env);
+    else
+      res = vfm_run_fast(env);
+  } while (res == VFM_SWITCH);
+  return (res);
+}
+#endif
+
+// TODO: Add document block per operation and use a script to extract
+// TODO: Extension operation to call C function through table
+
+int VFM_RUN(vfm_env_t* env) 
+{
+
+// NB: Operation names and jump table generated by makefile (special.awk)
+
+static char* opname[VFM_OPMAX + 1] = {
+ "EXT0",
+ "EXT1",
+ "EXT2",
+ "EXT3",
+ "NEXT",
+ "TRACING",
+ "PROFILING",
+ "NEST",
+ "NNEST",
+ "UNNEST",
+ "UNNEZE",
+ "MEST",
+ "MESTI",
+ "UNMEST",
+ "UNMEZT",
+ "UNSLIT",
+ "UNLIT",
+ "BRA",
+ "BRAX",
+ "BRZX",
+ "BRZE",
+ "BRZN",
+ "DBZN",
+ "RBZN",
+ "RDBG",
+ "RBRI",
+ "RBNE",
+ "RDNE",
+ "TASK",
+ "LOCAL",
+ "HERE",
+ "ALLOT",
+ "TRACE",
+ "PROFILE",
+ "EXEC",
+ "CLOAD",
+ "CSTORE",
+ "LOAD",
+ "STORE",
+ "ICLOAD",
+ "ICSTORE",
+ "ILOAD",
+ "ISTORE",
+ "RPUSH",
+ "RDUP",
+ "RPOP",
+ "RCOPY",
+ "LIT",
+ "CLIT",
+ "PLIT",
+ "SLIT",
+ "DEPTH",
+ "DROP",
+ "NIP",
+ "EMPTY",
+ "DUP",
+ "DUPNZ",
+ "OVER",
+ "TUCK",
+ "PICK",
+ "SWAP",
+ "ROT",
+ "TOR",
+ "ROLL",
+ "CELL",
+ "CONSTN2",
+ "CONSTN1",
+ "CONST0",
+ "CONST1",
+ "CONST2",
+ "CONST3",
+ "TRUE",
+ "FALSE",
+ "NOT",
+ "AND",
+ "OR",
+ "XOR",
+ "NEG",
+ "INC",
+ "DEC",
+ "INC2",
+ "DEC2",
+ "MUL2",
+ "DIV2",
+ "ADD",
+ "SUB",
+ "MUL",
+ "MULDIV",
+ "DIV",
+ "REM",
+ "DIVREM",
+ "LSH",
+ "RSH",
+ "ZNE",
+ "ZLT",
+ "ZLE",
+ "ZEQ",
+ "ZGE",
+ "ZGT",
+ "NE",
+ "LT",
+ "LE",
+ "EQ",
+ "GE",
+ "GT",
+ "WITHIN",
+ "ABS",
+ "MIN",
+ "MAX",
+ "DUMP",
+ "PUTC",
+ "PUTI",
+ "PUTX",
+ "PUTS",
+ "CR",
+ "GETC",
+ "GETS",
+ "VERSION",
+ "IDENT",
+ "HALT",
+ "OVER_EQ_BRZE",
+ "DUP_BRZE",
+ "CLIT_ADD",
+ "LIT_STORE",
+ "RPUSH_RPUSH",
+ "RCOPY_ADD",
+ 0
+};
+
+static void* optab[VFM_OPMAX + 1] = {
+ &&EXT0,
+ &&TRAP,
+ &&TRAP,
+ &&TRAP,
+ &&NEXT,
+ &&TRAP,
+ &&TRAP,
+ &&NEST,
+ &&NNEST,
+ &&UNNEST,
+ &&TRAP,
+ &&MEST,
+ &&TRAP,
+ &&UNMEST,
+ &&TRAP,
+ &&UNSLIT,
+ &&UNLIT,
+ &&BRA,
+ &&BRAX,
+ &&BRZX,
+ &&BRZE,
+ &&BRZN,
+ &&TRAP,
+ &&RBZN,
+ &&RDBG,
+ &&TRAP,
+ &&RBNE,
+ &&RDNE,
+ &&TASK,
+ &&TRAP,
+ &&HERE,
+ &&TRAP,
+ &&TRAP,
+ &&TRAP,
+ &&EXEC,
+ &&CLOAD,
+ &&CSTORE,
+ &&LOAD,
+ &&STORE,
+ &&TRAP,
+ &&TRAP,
+ &&TRAP,
+ &&TRAP,
+ &&RPUSH,
+ &&TRAP,
+ &&TRAP,
+ &&RCOPY,
+ &&LIT,
+ &&CLIT,
+ &&PLIT,
+ &&SLIT,
+ &&DEPTH,
+ &&DROP,
+ &&TRAP,
+ &&EMPTY,
+ &&DUP,
+ &&DUPNZ,
+ &&OVER,
+ &&TRAP,
+ &&TRAP,
+ &&SWAP,
+ &&ROT,
+ &&TRAP,
+ &&TRAP,
+ &&CELL,
+ &&CONSTN2,
+ &&TRAP,
+ &&CONST0,
+ &&CONST1,
+ &&CONST2,
+ &&CONST3,
+ &&TRUE,
+ &&FALSE,
+ &&TRAP,
+ &&TRAP,
+ &&TRAP,
+ &&TRAP,
+ &&NEG,
+ &&INC,
+ &&DEC,
+ &&TRAP,
+ &&DEC2,
+ &&TRAP,
+ &&TRAP,
+ &&ADD,
+ &&SUB,
+ &&MUL,
+ &&TRAP,
+ &&DIV,
+ &&REM,
+ &&TRAP,
+ &&LSH,
+ &&RSH,
+ &&TRAP,
+ &&ZLT,
+ &&ZLE,
+ &&ZEQ,
+ &&TRAP,
+ &&ZGT,
+ &&TRAP,
+ &&TRAP,
+ &&TRAP,
+ &&EQ,
+ &&TRAP,
+ &&GT,
+ &&WITHIN,
+ &&ABS,
+ &&MIN,
+ &&MAX,
+ &&DUMP,
+ &&TRAP,
+ &&PUTI,
+ &&PUTX,
+ &&PUTS,
+ &&CR,
+ &&TRAP,
+ &&TRAP,
+ &&VERSION,
+ &&IDENT,
+ &&HALT,
+ &&OVER_EQ_BRZE,
+ &&DUP_BRZE,
+ &&TRAP,
+ &&TRAP,
+ &&RPUSH_RPUSH,
+ &&TRAP,
+ [VFM_OP_LAST + 1 ... VFM_OPMAX] = &&TRAP
+};
+
+  if (!env) {
+    vfm_optab = optab;
+    vfm_opname = opname;
+    return (0);
+  }
+
+#if defined(VFM_USE_NEXT_POINTER) 
+  register void* np = &&NEXT;
+#endif
+  vfm_data_t* sp = env->sp;
+  register vfm_data_t tos = ((env->sp != env->sp0) ? *sp-- : 0);
+  vfm_code_t** rp = env->rp;
+  vfm_code_t* ip = env->ip;
+  vfm_data_t* dp = env->dp;
+  vfm_mod_t* mp = env->mp;
+  vfm_data_t ir;
+  int tmp;
+
+  // Check some basic invariants
+  if (ip < mp->segment.code || ip > (mp->segment.code + mp->segment.size)) {
+    return (VFM_ERR);
+  }
+
+  __sync_fetch_and_add(&vfm_tasks, 1);
+
+#if defined(VFM_USE_NEXT_POINTER) 
+  // Restore correct inner interpreter
+  np = (env->status & VFM_TRACING_STATUS) ? &&TRACING : np;
+  if (np == &&NEXT && (env->status & VFM_PROFILING_STATUS))
+    np = &&PROFILING;
+  // Get the profiling data right; entry is not counted when resuming
+  if (np != &&NEXT && !(env->status & VFM_RESUME_STATUS)) {
+    vfm_oprefcnt[VFM_OP_NEST] += 1;
+    inc_refcnt(ip, &mp->dict);
+  }
+#endif
+  env->status &= ~VFM_RESUME_STATUS;
+
+  // Let go; serve any pending requests first
+  if (vfm_request) goto REQUEST;
+  NEXT();
+
+// NB: EXT0...EXT3 should be opcode (0..3) as opcode is page number
+// NB: EXT0 n == n when n < 128. EXT0(VFM_OP_ADD) == VFM_OP_ADD
+// NB: EXT0..EXT3 are extension pages for future usage
+// NB: Allows 1024 opcodes (primitive instructions)
+
+OP(NEXT) // nop ( -- )
+  if ((ir = *ip++) >= 0)
+    goto *optab[ir];
+#if !defined(VFM_USE_NEXT_POINTER)
+ NEXT0:
+#endif
+  ir = ((ir << 8) | (*(ip++) & 0xff));
+  *++rp = ip;
+  ip = ip + ir;
+  if (vfm_request) goto REQUEST;
+  goto NEXT;
+
+// NB: External requests (signal handlers) are polled on run, function
+// NB: and module call, and backward branch. The safepoint request is
+// NB: left for the other environments; the state is saved and the
+// NB: environment is parked until the request is withdrawn
+
+ REQUEST:
+  tmp = __sync_fetch_and_and(&vfm_request, VFM_SAFEPOINT_REQUEST);
+  if (tmp & (VFM_SNAPSHOT_REQUEST | VFM_SAFEPOINT_REQUEST)) {
+    env->sp = sp;
+    if (sp != env->sp0) *++env->sp = tos;
+    env->ip = ip;
+    env->rp = rp;
+    env->dp = dp;
+    env->mp = mp;
+  }
+  if (tmp & VFM_SNAPSHOT_REQUEST) vfm_snapshot(env);
+  if (tmp & VFM_SAFEPOINT_REQUEST) vfm_park(env);
+  if (tmp & VFM_PROFILE_REQUEST) {
+    env->status ^= VFM_PROFILING_STATUS;
+    goto ENGINE;
+  }
+  NEXT();
+
+// NB: Select inner interpreter after status change; switch engine when
+// NB: tracing and profiling is turned on (fast) or off (instrumented)
+
+ ENGINE:
+#if defined(VFM_USE_NEXT_POINTER)
+  if (!(env->status & VFM_INSTRUMENTED_STATUS)) goto SWITCH;
+  np = (env->status & VFM_TRACING_STATUS) ? &&TRACING : &&PROFILING;
+#else
+  if (env->status & VFM_INSTRUMENTED_STATUS) goto SWITCH;
+#endif
+  NEXT();
+
+OP(NEST) // [2]
+  ir = *ip++;
+  ir = ((ir << 8) | (*(ip++) & 0xff));
+  *++rp = ip;
+  ip = ip + ir;
+  NEXT();
+
+OP(UNNEST)
+  ip = *rp--;
+  NEXT();
+
+OP(CLIT) // 100 ( -- x ) [1]
+  *++sp = tos; 
+  tos = (vfm_data_t) *ip++;
+  NEXT();
+
+OP(EMPTY) // empty ( -- )
+  sp = env->sp0;
+  NEXT();
+
+OP(DUP) // dup ( x -- x x )
+  *++sp = tos;
+  NEXT();
+
+OP(PUTS)
+  fputs((char*) tos, stdout);
+  tos = *sp--;
+  NEXT();
+
+OP(CR)
+  putc('\n', stdout);
+  NEXT();
+
+OP(LOAD) // @ ( addr -- x )
+  tos = *((vfm_data_t*) tos);
+  NEXT();
+
+OP(SLIT) // [-1]
+  ir = *ip++;
+  *++sp = tos;
+  tos = (int) ip;
+  ip = ip + (unsigned) ir; 
+  NEXT();
+
+OP(ADD) // + ( x y -- z )
+  tos = *sp-- + tos;
+  NEXT();
+
+OP(MEST) // [3]
+  ir = *ip++;
+  *(++rp) = (vfm_code_t*) mp;
+  mp = mp->use.mod[ir];
+  if (!VFM_LOADED(mp) && vfm_resolve(mp)) goto UNRESOLVED;
+  ir = *ip++;
+  ir = ((ir << 8) | (*(ip++) & 0xff));
+  *(++rp) = ip;
+  ip = mp->segment.code + ir;
+  if (vfm_request) goto REQUEST;
+  NEXT();
+
+// NB: MESTI is a module call that requires module index(int8) and symbol index(int8)
+// NB: This requires that symbols are loaded. Should be checked or flagged in object header.
+
+OP(UNMEST)
+  mp = (vfm_mod_t*) *rp--;
+  NEXT();
+
+OP(PUTX)
+  fprintf(stdout, "0x%x ", (int) tos);
+  tos = *sp--;
+  NEXT();
+
+OP(DROP) // drop ( x -- )
+  tos = *sp--;
+  NEXT();
+
+OP(CONST1) // 1 ( -- n )
+  *++sp = tos;
+  tos = 1;
+  NEXT();
+
+OP(CELL) // cell ( -- n )
+  *++sp = tos;
+  tos = sizeof(vfm_data_t);
+  NEXT();
+
+OP(LIT) // 1000 ( -- x ) [4]
+  *++sp = tos; 
+  tos = (vfm_data_t) *ip++;
+  tos = ((tos << 8) | (*(ip++) & 0xff));
+  tos = ((tos << 8) | (*(ip++) & 0xff));
+  tos = ((tos << 8) | (*(ip++) & 0xff));
+  NEXT();
+
+OP(BRA) // [1]
+  ir = *ip++;
+  ip = ip + ir; 
+  POLL(ir);
+  NEXT();
+
+OP(RCOPY) // i ( -- x )
+  *++sp = tos;
+  tos = (vfm_data_t) *rp;
+  NEXT();
+
+OP(RPUSH)
+  *++rp = (vfm_code_t*) tos;
+  tos = *sp--;
+  NEXT();
+
+OP(CONST3) // 3 ( -- n )
+  *++sp = tos;
+  tos = 3;
+  NEXT();
+
+OP(INC) // 1+ ( x -- y )
+  tos += 1;
+  NEXT();
+
+OP(DEC) // 1- ( x -- y )
+  tos -= 1;
+  NEXT();
+
+OP(BRZE) // [1]
+  ir = *ip++;
+  ip = ip + ((-(tos == 0)) & ir);
+  tos = *sp--;
+  POLL(ir);
+  NEXT();    
+
+OP(RBZN) // [1]
+  ir = *ip++;
+  *rp = *rp - 1;
+  if (((int) *rp) >= 0)
+    ip = ip + ir;
+  else
+    rp = rp - 1;
+  POLL(ir);
+  NEXT();    
+
+OP(CONST0) // 0 ( -- n )
+  *++sp = tos;
+  tos = 0;
+  NEXT();
+
+OP(CONST2) // 2 ( -- n )
+  *++sp = tos;
+  tos = 2;
+  NEXT();
+
+OP(STORE) // ! ( x addr -- )
+  *((vfm_data_t*) tos) = *sp--;
+  tos = *sp--;
+  NEXT();
+
+OP(DUPNZ) // ?dup ( x -- x x )
+  if (tos != 0) 
+    *++sp = tos;
+  NEXT();
+
+OP(PUTI)
+  fprintf(stdout, "%d ", (int) tos);
+  tos = *sp--;
+  NEXT();
+
+OP(WITHIN) // within ( x lo hi -- flag )
+  tmp = *sp--;
+  tos = -((*sp <= tos) & (*sp >= tmp));
+  NEXT();
+
+OP(EXT0) // [1]
+  ir = (*(ip++) & 0xff);
+  goto *optab[ir];
+
+OP(CLOAD) // c@ ( addr -- c )
+  tos = *((char*) tos);
+  NEXT();
+
+OP(CSTORE) // c! ( c addr -- )
+  *((char*) tos) = *sp--;
+  tos = *sp--;
+  NEXT();
+
+OP(SWAP) // swap ( x y -- y x )
+  tmp = tos;
+  tos = *sp;
+  *sp = tmp;
+  NEXT();
+
+OP(MUL) // * ( x y -- z )
+  tos = *sp-- * tos;
+  NEXT();
+
+OP(ABS) // abs ( x -- y )
+  tos = ((-(tos < 0)) & (-tos)) | ((-(tos >= 0)) & tos);
+  NEXT();
+
+OP(UNSLIT)
+  *++sp = tos;
+  tos = (int) ip;
+  ip = *rp--;
+  NEXT();
+
+OP(OVER) // over ( x y -- x y x )
+  tmp = *sp;
+  *++sp = tos;
+  tos = tmp;
+  NEXT();
+
+OP(CONSTN2) // -2 ( -- n )
+  *++sp = tos;
+  tos = -2;
+  NEXT();
+
+OP(BRAX) // [2]
+  ir = *ip++;
+  ir = ((ir << 8) | (*(ip++) & 0xff));
+  ip = ip + ir; 
+  POLL(ir);
+  NEXT();
+
+// NB: Conditional operations are optimized for non stalling pipeline
+
+OP(BRZX) // [2]
+  ir = *ip++;
+  ir = ((ir << 8) | (*(ip++) & 0xff));
+  ip = ip + ((-(tos == 0)) & ir);
+  tos = *sp--;
+  POLL(ir);
+  NEXT();
+
+OP(BRZN) // [1]
+  ir = *ip++;
+  ip = ip + ((-(tos != 0)) & ir);
+  tos = *sp--;
+  POLL(ir);
+  NEXT();    
+
+OP(GT) // > ( x y -- flag )
+  tos = -(*sp-- > tos);
+  NEXT();
+
+OP(MIN) // min ( x y -- z )
+  tos = ((-(tos < *sp) & tos) | (-(tos >= *sp) & *sp));
+  sp = sp - 1;
+  NEXT();
+
+OP(MAX) // max ( x y -- z )
+  tos = ((-(tos > *sp) & tos) | (-(tos <= *sp) & *sp));
+  sp = sp - 1;
+  NEXT();
+
+
+// NB: Superinstructions; fused operation sequences selected by the
+// NB: compiler peephole optimizer (compiler.c::gen_super). The name is
+// NB: the list of fused operations (see makefile, supertab.i). They are
+// NB: appended after HALT so that the base operation codes are kept.
+
+OP(OVER_EQ_BRZE) // [1]
+  ir = *ip++;
+  ip = ip + ((-(tos != *sp)) & ir);
+  tos = *sp--;
+  POLL(ir);
+  NEXT();
+OP(HERE) // here ( -- addr )
+  *++sp = tos;
+  tos = (vfm_data_t) dp;
+  NEXT();
+  
+OP(TRUE) // true ( -- flag )
+  *++sp = tos;
+  tos = -1;
+  NEXT();
+
+OP(FALSE) // false ( -- flag )
+  *++sp = tos;
+  tos = 0;
+  NEXT();
+
+OP(NEG) // negate ( x -- y )
+  tos = -tos;
+  NEXT();
+    
+OP(SUB) // - ( x y -- z )
+  tos = *sp-- - tos;
+  NEXT();
+
+OP(DIV) // / ( x y -- z )
+  tos = *sp-- / tos;
+  NEXT();
+
+OP(LSH) // << ( x n -- y )
+  tos = *sp-- << tos;
+  NEXT();
+
+OP(RSH) // >> ( x n -- y )
+  tos = *sp-- >> tos;
+  NEXT();
+
+OP(ZEQ) // 0= ( x -- flag )
+  tos = -(tos == 0);
+  NEXT();
+
+OP(ZGT) // 0> ( x -- flag )
+  tos = -(tos > 0);
+  NEXT();
+
+
+OP(RPUSH_RPUSH)
+  *++rp = (vfm_code_t*) tos;
+  *++rp = (vfm_code_t*) *sp--;
+  tos = *sp--;
+  NEXT();
+OP(NNEST) // [-1]
+  ir = *ip++;
+  tmp = 2 * tos;
+  tos = *sp--;
+  if (tmp >= 0 && tmp < ir) {
+    *++rp = ip + ir;
+    ip = ip + tmp;
+    ir = *ip++;
+    ir = ((ir << 8) | (*(ip++) & 0xff));
+  }
+  ip = ip + ir;
+  NEXT();
+
+OP(UNLIT) // [4]
+  *++sp = tos;
+  tos = (vfm_data_t) *ip++;
+  tos = ((tos << 8) | (*(ip++) & 0xff));
+  tos = ((tos << 8) | (*(ip++) & 0xff));
+  tos = ((tos << 8) | (*(ip++) & 0xff));
+  ip = *rp--;
+  NEXT();
+
+OP(RDBG) // [1]
+  ir = *ip++;
+  *rp = *rp - tos;
+  if (((int) *rp) >= 0)
+    ip = ip + ir;
+  else
+    rp = rp - 1;
+  tos = *sp--;
+  POLL(ir);
+  NEXT();    
+
+OP(RBNE) // [1]
+  ir = *ip++;
+  *rp = *rp + 1;
+  if (*rp <= *(rp - 1))
+    ip = ip + ir;
+  else
+    rp = rp - 2;
+  POLL(ir);
+  NEXT();    
+
+OP(RDNE) // [1]
+  ir = *ip++;
+  *rp = *rp + tos;
+  if (*rp <= *(rp - 1))
+    ip = ip + ir;
+  else
+    rp = rp - 2;
+  tos = *sp--;
+  POLL(ir);
+  NEXT();    
+
+OP(TASK) // task ( -- addr )
+  *++sp = tos;
+  tos = (vfm_data_t) env;
+  NEXT();
+
+OP(EXEC) // execute ( xt -- )
+  *++rp = ip;
+  ip = (vfm_code_t*) tos;
+  tos = *sp--;
+  NEXT();   
+
+OP(PLIT) // [2]
+  *++sp = tos; 
+  ir = *ip++;
+  ir = ((ir << 8) | (*(ip++) & 0xff));
+  tos = (vfm_data_t) (ip + ir);
+  NEXT();
+
+OP(DEPTH) // depth ( -- n )
+  tmp = (sp - env->sp0);
+  *++sp = tos;
+  tos = tmp;
+  NEXT();
+
+OP(ROT) // rot ( x y z -- y z x )
+  tmp = tos;
+  tos = *(sp - 1);
+  *(sp - 1) = *sp;
+  *sp = tmp;
+  NEXT();
+
+OP(DEC2) // 2- ( x -- y )
+  tos -= 2;
+  NEXT();
+
+OP(REM) // % ( x y -- z )
+  tos = *sp-- % tos;
+  NEXT();
+
+OP(ZLT) // 0< ( x -- flag )
+  tos = -(tos < 0);
+  NEXT();
+
+OP(ZLE) // 0<= ( x -- flag )
+  tos = -(tos <= 0);
+  NEXT();
+
+OP(EQ) // == ( x y -- flag )
+  tos = -(*sp-- == tos);
+  NEXT();
+
+OP(DUMP)
+  tmp = (sp - env->sp0);
+  fprintf(stdout, "[%d] ", (int) tmp);
+  if (tmp > 0) {
+    vfm_data_t* tp = env->sp0 + 1;
+    while (--tmp) {
+      fprintf(stdout, "%d ", (int) *++tp);
+    }
+    fprintf(stdout, "%d", (int) tos);
+  }
+  fprintf(stdout, "\n");
+  NEXT();
+
+// TODO: Memory block read/write
+// TODO: Read line from input stream; expect
+
+OP(VERSION)
+  *++sp = tos;
+  tos = (vfm_data_t) mp->version;
+  NEXT();
+
+OP(IDENT)
+  *++sp = tos;
+  tos = (vfm_data_t) mp->ident;
+  NEXT();
+
+
+OP(DUP_BRZE) // [1]
+  ir = *ip++;
+  ip = ip + ((-(tos == 0)) & ir);
+  POLL(ir);
+  NEXT();
+OP(HALT)
+  __sync_fetch_and_sub(&vfm_tasks, 1);
+  if (sp != env->sp0) *++sp = tos;
+  env->sp = sp;
+  env->ip = ip;
+  env->rp = rp;
+  env->dp = dp;
+  env->mp = mp;
+  return ((env->status & VFM_RESUME_STATUS) ? VFM_SWITCH : 0);
+
+// NB: Engine switch; state is saved as on halt and resumed by vfm_run
+
+ SWITCH:
+  env->status |= VFM_RESUME_STATUS;
+  goto HALT;
+
+// NB: Module call to a used module that could not be loaded (lazy).
+// NB: Only the module index has been read (MEST, MESTI); the state is
+// NB: saved with the instruction pointer at the operation so that the
+// NB: call is retried when the environment is resumed
+
+ UNRESOLVED: __attribute__((unused));
+  mp = (vfm_mod_t*) *rp--;
+  ip -= 2;
+  __sync_fetch_and_sub(&vfm_tasks, 1);
+  if (sp != env->sp0) *++sp = tos;
+  env->sp = sp;
+  env->ip = ip;
+  env->rp = rp;
+  env->dp = dp;
+  env->mp = mp;
+  return (vfm_errno);
+
+#if defined(VFM_SPECIAL_ENGINE)
+// NB: Operations not in the specialized engine (special.c) trap.
+// NB: State is saved with the instruction pointer after the operation
+
+ TRAP:
+  vfm_errno = VFM_TRAP_ERR;
+  __sync_fetch_and_sub(&vfm_tasks, 1);
+  if (sp != env->sp0) *++sp = tos;
+  env->sp = sp;
+  env->ip = ip;
+  env->rp = rp;
+  env->dp = dp;
+  env->mp = mp;
+  return (VFM_TRAP_ERR);
+#endif
+}
+
@@ -0,0 +1,8 @@
+// NB: Superinstruction table generated by makefile
+
+  { VFM_OP_OVER_EQ_BRZE, { VFM_OP_OVER, VFM_OP_EQ, VFM_OP_BRZE } },
+  { VFM_OP_DUP_BRZE, { VFM_OP_DUP, VFM_OP_BRZE } },
+  { VFM_OP_CLIT_ADD, { VFM_OP_CLIT, VFM_OP_ADD } },
+  { VFM_OP_LIT_STORE, { VFM_OP_LIT, VFM_OP_STORE } },
+  { VFM_OP_RPUSH_RPUSH, { VFM_OP_RPUSH, VFM_OP_RPUSH } },
+  { VFM_OP_RCOPY_ADD, { VFM_OP_RCOPY, VFM_OP_ADD } },
@@ -0,0 +1,33 @@
+#ifndef _test_test0_i_
+#define _test_test0_i_
+vfm_code_t test_test0_code[] = {
+  0x00, 0x75, 0x76, 0x09, 0x01, 0xff, 0xfa, 0x71, 
+  0x32, 0x02, 0x20, 0x00, 0x71, 0x71, 0x72, 0x09, 
+};
+vfm_symb_t test_test0_symbols[] = {
+  { "rev", test_test0_code + 1, 0, 1 },
+  { "main", test_test0_code + 5, 0, 1 },
+};
+vfm_mod_t test_test0_mod = {
+  "test.test0",
+  "@(#) vfm/test, Copyright 2009, Mikael Patel",
+  "$Rev: 5 $",
+  1792393585,
+  {
+    0,
+    0,
+    0, 
+  },
+  {
+    2,
+    2,
+    test_test0_symbols
+  },
+  {
+    16,
+    16,
+    test_test0_code,
+    test_test0_code + 5,
+  }
+};
+#endif
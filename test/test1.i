@@ -0,0 +1,81 @@
+#ifndef _test_test1_i_
+#define _test_test1_i_
+vfm_code_t test_test1_code[] = {
+  0x00, 0x09, 0x01, 0xff, 0xfc, 0x09, 0x02, 0xff, 
+  0xfa, 0x09, 0x03, 0xff, 0xfa, 0x09, 0x04, 0xff, 
+  0xfa, 0x09, 0x05, 0x14, 0x03, 0x41, 0x11, 0x01, 
+  0x45, 0x09, 0x06, 0x15, 0x03, 0x41, 0x11, 0x01, 
+  0x45, 0x09, 0x07, 0x09, 0x08, 0x04, 0x04, 0x04, 
+  0x04, 0x04, 0x09, 0x09, 0xff, 0xe1, 0x09, 0x0a, 
+  0x48, 0xff, 0xe0, 0x47, 0xff, 0xdd, 0x48, 0xff, 
+  0xe2, 0x47, 0xff, 0xdf, 0x09, 0x0b, 0x44, 0x45, 
+  0x54, 0x46, 0x56, 0x30, 0x04, 0x58, 0x45, 0x66, 
+  0x09, 0x0c, 0x44, 0x41, 0x46, 0x3c, 0x3d, 0x37, 
+  0x33, 0x34, 0x39, 0x38, 0x43, 0x38, 0x09, 0x0d, 
+  0x44, 0x41, 0x54, 0x46, 0x56, 0x4e, 0x37, 0x30, 
+  0x04, 0x58, 0x4f, 0x4d, 0x59, 0x60, 0x62, 0x5f, 
+  0x5e, 0x09, 0x0e, 0x30, 0x05, 0x4f, 0x37, 0x15, 
+  0xfc, 0x34, 0x09, 0x0f, 0x30, 0x05, 0x4f, 0x79, 
+  0x02, 0x11, 0xfb, 0x34, 0x09, 0x10, 0x30, 0x05, 
+  0x2b, 0x2e, 0x17, 0xfd, 0x09, 0x11, 0x30, 0x0a, 
+  0x2b, 0x2e, 0x46, 0x18, 0xfc, 0x09, 0x12, 0x43, 
+  0x30, 0x0a, 0x7c, 0x2e, 0x1a, 0xfd, 0x09, 0x13, 
+  0x43, 0x30, 0x0a, 0x7c, 0x2e, 0x46, 0x1b, 0xfc, 
+  0x09, 0x14, 0x30, 0x05, 0x38, 0x14, 0x03, 0x4f, 
+  0x11, 0x01, 0x09, 0x11, 0xf7, 0x09, 0x15, 0x00, 
+  0x04, 0x00, 0x04, 0x00, 0x04, 0x00, 0x04, 0x00, 
+  0x04, 0x09, 0x16, 0xff, 0x66, 0x36, 0xff, 0x65, 
+  0x36, 0xff, 0x69, 0x36, 0xff, 0x6a, 0x36, 0xff, 
+  0x75, 0x36, 0xff, 0x7e, 0x36, 0xff, 0x89, 0x36, 
+  0xff, 0x99, 0x36, 0xff, 0x9f, 0x36, 0xff, 0xa6, 
+  0x36, 0xff, 0xab, 0x36, 0xff, 0xb1, 0x36, 0xff, 
+  0xb7, 0x36, 0xff, 0xbe, 0x36, 0xff, 0xc8, 0x36, 
+  0x09, };
+vfm_symb_t test_test1_symbols[] = {
+  { "fun1", test_test1_code + 1, 0, 1 },
+  { "fun2", test_test1_code + 3, 0, 1 },
+  { "fun3", test_test1_code + 7, 0, 1 },
+  { "fun4", test_test1_code + 11, 0, 1 },
+  { "fun5", test_test1_code + 15, 0, 1 },
+  { "fun6", test_test1_code + 19, 0, 2 },
+  { "fun7", test_test1_code + 27, 0, 2 },
+  { "test0", test_test1_code + 35, 0, 1 },
+  { "test1", test_test1_code + 37, 0, 1 },
+  { "test2", test_test1_code + 44, 0, 1 },
+  { "test3", test_test1_code + 48, 0, 1 },
+  { "test4", test_test1_code + 62, 0, 1 },
+  { "test5", test_test1_code + 74, 0, 1 },
+  { "test6", test_test1_code + 88, 0, 1 },
+  { "test7", test_test1_code + 107, 0, 1 },
+  { "test8", test_test1_code + 116, 0, 1 },
+  { "test9", test_test1_code + 126, 0, 1 },
+  { "test10", test_test1_code + 134, 0, 1 },
+  { "test11", test_test1_code + 143, 0, 1 },
+  { "test12", test_test1_code + 152, 0, 1 },
+  { "test13", test_test1_code + 162, 0, 1 },
+  { "test14", test_test1_code + 175, 0, 1 },
+  { "main", test_test1_code + 187, 0, 1 },
+};
+vfm_mod_t test_test1_mod = {
+  "test.test1",
+  "",
+  "",
+  1792393585,
+  {
+    0,
+    0,
+    0, 
+  },
+  {
+    23,
+    23,
+    test_test1_symbols
+  },
+  {
+    233,
+    233,
+    test_test1_code,
+    test_test1_code + 187,
+  }
+};
+#endif
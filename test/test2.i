@@ -0,0 +1,48 @@
+#ifndef _test_test2_i_
+#define _test_test2_i_
+vfm_code_t test_test2_code[] = {
+  0x00, 0x38, 0x14, 0x06, 0x37, 0x4f, 0xff, 0xf9, 
+  0x56, 0x09, 0x44, 0x09, 0x01, 0x44, 0x3c, 0x2b, 
+  0x2e, 0x38, 0x14, 0x01, 0x56, 0x17, 0xf9, 0x09, 
+  0x02, 0x37, 0x45, 0x68, 0x14, 0x0a, 0x37, 0x4f, 
+  0xff, 0xf7, 0x3c, 0x51, 0xff, 0xf3, 0x54, 0x09, 
+  0x34, 0x44, 0x09, 0x03, 0x30, 0x05, 0x2b, 0x2e, 
+  0xff, 0xcf, 0x17, 0xfb, 0x09, 0x04, 0x30, 0x05, 
+  0x2b, 0x2e, 0xff, 0xdd, 0x17, 0xfb, 0x09, 0x05, 
+  0x30, 0x05, 0x2b, 0x2e, 0xff, 0xc7, 0x17, 0xfb, 
+  0x09, 0x06, 0x30, 0x28, 0xff, 0xcb, 0x09, 0x07, 
+  0xff, 0xda, 0x36, 0xff, 0xe1, 0x36, 0xff, 0xe8, 
+  0x36, 0x09, };
+vfm_symb_t test_test2_symbols[] = {
+  { "fac", test_test2_code + 1, 0, 2 },
+  { "iter-fac", test_test2_code + 13, 0, 1 },
+  { "fib", test_test2_code + 25, 0, 4 },
+  { "test1", test_test2_code + 44, 0, 1 },
+  { "test2", test_test2_code + 54, 0, 1 },
+  { "test3", test_test2_code + 64, 0, 1 },
+  { "test4", test_test2_code + 74, 0, 0 },
+  { "main", test_test2_code + 80, 0, 1 },
+};
+vfm_mod_t test_test2_mod = {
+  "test.test2",
+  "",
+  "",
+  1792393585,
+  {
+    0,
+    0,
+    0, 
+  },
+  {
+    8,
+    8,
+    test_test2_symbols
+  },
+  {
+    90,
+    90,
+    test_test2_code,
+    test_test2_code + 80,
+  }
+};
+#endif
@@ -0,0 +1,56 @@
+#ifndef _test_test3_i_
+#define _test_test3_i_
+#include "test/test0.i"
+#include "test/test1.i"
+#include "test/test2.i"
+vfm_code_t test_test3_code[] = {
+  0x00, 0x0b, 0x01, 0x00, 0x0f, 0x0d, 0x09, 0x01, 
+  0x30, 0x05, 0x0b, 0x02, 0x00, 0x01, 0x0d, 0x09, 
+  0x02, 0x30, 0x05, 0x0b, 0x02, 0x00, 0x19, 0x0d, 
+  0x09, 0x03, 0x0b, 0x01, 0x00, 0x0f, 0x0d, 0xff, 
+  0xe0, 0xff, 0xe5, 0xff, 0xec, 0x09, 0x04, 0x0b, 
+  0x02, 0x00, 0x01, 0x0d, 0x09, 0x05, 0x30, 0x05, 
+  0x3c, 0x22, 0x09, 0x06, 0x31, 0xff, 0xf0, 0xff, 
+  0xf5, 0x09, 0x07, 0x0b, 0x00, 0x00, 0x01, 0x0d, 
+  0x71, 0x32, 0x02, 0x20, 0x00, 0x71, 0x71, 0x72, 
+  0x0b, 0x01, 0x00, 0xbb, 0x0d, 0x36, 0x0b, 0x02, 
+  0x00, 0x50, 0x0d, 0x36, 0xff, 0xc4, 0x36, 0xff, 
+  0xdb, 0x36, 0x09, };
+vfm_symb_t test_test3_symbols[] = {
+  { "foo", test_test3_code + 1, 0, 1 },
+  { "fie", test_test3_code + 8, 0, 1 },
+  { "fum", test_test3_code + 17, 0, 1 },
+  { "test1", test_test3_code + 26, 0, 1 },
+  { "fac", test_test3_code + 39, 0, 1 },
+  { "five", test_test3_code + 46, 0, 1 },
+  { "test2", test_test3_code + 52, 0, 1 },
+  { "main", test_test3_code + 59, 0, 1 },
+};
+vfm_mod_t* test_test3_use[] = {
+  &test_test0_mod, 
+  &test_test1_mod, 
+  &test_test2_mod, 
+};
+vfm_mod_t test_test3_mod = {
+  "test.test3",
+  "",
+  "",
+  1792393585,
+  {
+    3,
+    3,
+    test_test3_use, 
+  },
+  {
+    8,
+    8,
+    test_test3_symbols
+  },
+  {
+    91,
+    91,
+    test_test3_code,
+    test_test3_code + 59,
+  }
+};
+#endif
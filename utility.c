@@ -16,6 +16,7 @@
 
 #include "vfm.h"
 #include <string.h>
+#include <stdlib.h>
 #include <endian.h>
 
 int fgetint(int* x, FILE* file)
@@ -34,6 +35,22 @@ int fputint(int n, FILE* file)
   return (fwrite(&x, sizeof(x), 1, file));
 }
 
+int fgetlong(long long* x, FILE* file)
+{
+  long long n;
+  int r;
+
+  r = fread(&n, sizeof(n), 1, file);
+  *x = be64toh(n);
+  return (r);
+}
+
+int fputlong(long long n, FILE* file)
+{
+  long long x = htobe64(n);
+  return (fwrite(&x, sizeof(x), 1, file));
+}
+
 int fgetstr(char* buf, FILE* file)
 {
   char* bp = buf;
@@ -84,13 +101,88 @@ char* vfm_name2path(char* name)
   return (name);
 }
 
+// NB: Number of inline operand bytes following the operation code
+// NB: Variable length operations (NNEST, SLIT) return -1. The table is
+// NB: generated from the operation annotations in runtime.c
+
+#include "opsize.i"
+
+int vfm_opsize(int op)
+{
+  if (op < 0 || op > VFM_OPMAX) return (0);
+  return (opsize[op]);
+}
+
+// NB: Symbol name index; symbols are chained from the latest in each
+// NB: bucket. The first match below count is returned so that later
+// NB: definitions shadow earlier (guard hides the latest by decrementing
+// NB: count). Appended symbols are added; the index is rebuilt with
+// NB: double size when the number of symbols exceeds the buckets.
+
+#define VFM_DICT_BUCKETS 64
+
+unsigned vfm_strhash(char* s)
+{
+  unsigned h = 0;
+  while (*s) h = h * 31 + (unsigned char) *s++;
+  return (h);
+}
+
+static int index_dict(vfm_dict_t *dict)
+{
+  unsigned h;
+  int buckets;
+  int i;
+
+  // Rebuild index when full
+  if (dict->count > dict->buckets) {
+    buckets = (dict->buckets ? dict->buckets : VFM_DICT_BUCKETS);
+    while (buckets < dict->count) buckets *= 2;
+    free(dict->bucket);
+    free(dict->chain);
+    dict->bucket = (int*) malloc(sizeof(int) * buckets);
+    dict->chain = (int*) malloc(sizeof(int) * buckets);
+    dict->buckets = 0;
+    dict->indexed = 0;
+    if (!dict->bucket || !dict->chain) return (VFM_MALLOC_ERR);
+    for (i = 0; i < buckets; i++) 
+      dict->bucket[i] = -1;
+    dict->buckets = buckets;
+  }
+
+  // Add symbols appended since last index
+  for (i = dict->indexed; i < dict->count; i++) {
+    h = vfm_strhash(dict->symbols[i].name) & (dict->buckets - 1);
+    dict->chain[i] = dict->bucket[h];
+    dict->bucket[h] = i;
+  }
+  if (dict->count > dict->indexed) dict->indexed = dict->count;
+  return (VFM_NOERR);
+}
+
+int vfm_dict_index(vfm_dict_t *dict)
+{
+  if (!dict) return (vfm_errno = VFM_ERR);
+  return (vfm_errno = index_dict(dict));
+}
+
 vfm_symb_t* vfm_name2symb(char* name, vfm_dict_t *dict)
 {
   if (!dict || !name || !*name) return (0);
+  if (VFM_PENDING(dict)) vfm_load_symbols(dict->pending);
+  if (!dict->count) return (0);
 
   vfm_symb_t *symbol = dict->symbols + dict->count - 1;
   int i;
 
+  // Hash index lookup; fallback to search from latest symbol
+  if (dict->count <= dict->indexed || !index_dict(dict)) {
+    i = dict->bucket[vfm_strhash(name) & (dict->buckets - 1)];
+    for (; i >= 0; i = dict->chain[i])
+      if (i < dict->count && !strcmp(name, dict->symbols[i].name))
+	return (&dict->symbols[i]);
+    return (0);
+  }
   for(i = 0; i < dict->count; i++, symbol--)
     if (!strcmp(name, symbol->name))
       return (symbol);
@@ -104,6 +196,7 @@ int vfm_name2dict(char* name, vfm_dict_t **dict, vfm_mod_t *mod)
 
   for (i = 0; i < mod->use.count; i++)
     if (!strcmp(name, mod->use.mod[i]->name)) {
+      if (!VFM_LOADED(mod->use.mod[i])) vfm_resolve(mod->use.mod[i]);
       *dict = &mod->use.mod[i]->dict;
       return (i);
     }
@@ -116,22 +209,29 @@ int vfm_name2dict(char* name, vfm_dict_t **dict, vfm_mod_t *mod)
 // #define LINEAR_SEARCH
 // #define BINARY_SEARCH
 // #define NO_SEARCH
-// NB: NO_SEARCH has a compiler dependency (symbol index inline at head)
-// NB: And a restriction on the number of symbols (256)
+// NB: NO_SEARCH has a compiler dependency (symbol index inline at head).
+// NB: The inline index is the low byte; symbols are in address order
+// NB: and probed every 256 symbols until the address is passed
 
 #define NO_SEARCH
 
 vfm_symb_t* vfm_addr2symb(vfm_code_t* addr, vfm_dict_t *dict)
 {
   if (!dict) return (0);
+  if (VFM_PENDING(dict)) vfm_load_symbols(dict->pending);
 
   vfm_symb_t *symbol = dict->symbols;
 
 #if defined(NO_SEARCH)
-  unsigned i = (unsigned) *(addr - 1);
-  if (i > dict->count)
-    return (0);
-  return (&symbol[i]);
+  int i;
+
+  for (i = (unsigned char) *(addr - 1); i < dict->count; i += 256) {
+    if (symbol[i].code == addr) 
+      return (&symbol[i]);
+    if (symbol[i].code > addr)
+      break;
+  }
+  return (0);
 
 #elif defined(LINEAR_SEARCH)
   int i;
@@ -158,6 +258,28 @@ vfm_symb_t* vfm_addr2symb(vfm_code_t* addr, vfm_dict_t *dict)
 #endif
 }
 
+vfm_line_t* vfm_addr2line(vfm_code_t* addr, vfm_mod_t *mod)
+{
+  if (!mod) return (0);
+  if (VFM_PENDING(&mod->dict)) vfm_load_symbols(mod);
+  if (!mod->ltab.count) return (0);
+
+  vfm_line_t* line = mod->ltab.lines;
+  int offset = addr - mod->segment.code;
+  int low = 0;
+  int high = mod->ltab.count;
+
+  // Binary search for the last line entry at or before the offset
+  while (low < high) {
+    int mid = low + ((high - low) / 2);
+    if (line[mid].offset <= offset)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return (low > 0 ? &line[low - 1] : 0);
+}
+
 int vfm_dump_module(FILE* file, int recursive, vfm_mod_t *mod)
 {
   if (!mod) return (vfm_errno = VFM_ERR);
@@ -182,6 +304,353 @@ int vfm_dump_module(FILE* file, int recursive, vfm_mod_t *mod)
   return (vfm_errno = VFM_NOERR);
 }
 
+// NB: Memory is calculated from the loaded module structure and
+// NB: corresponds to the allocations made by the loader (loader.c)
+
+// NB: Strings in the object image are accounted with the image
+
+static int strsize(char* s, vfm_mod_t *mod)
+{
+  if (s && s >= mod->image.base && s < mod->image.base + mod->image.size) 
+    return (0);
+  return (s ? strlen(s) + 1 : 0);
+}
+
+int vfm_memory(vfm_mem_t* mem, vfm_mod_t *mod)
+{
+  if (!mem || !mod) return (vfm_errno = VFM_ERR);
+
+  int i;
+
+  // Module structure, names and use list
+  mem->module = sizeof(vfm_mod_t) 
+    + strsize(mod->name, mod) + strsize(mod->ident, mod) 
+    + strsize(mod->version, mod);
+  if (mod->use.mod) 
+    mem->module += sizeof(vfm_mod_t*) * (mod->use.size + 1);
+
+  // Code segment or object image and instruction counters
+  mem->code = (mod->image.base ? mod->image.size - mod->image.offset 
+	       : mod->segment.size);
+  mem->counters = (mod->segment.refcnt ? sizeof(long long) * mod->segment.size : 0);
+
+  // Symbol table, name index and symbol names
+  mem->symbols = sizeof(vfm_symb_t) * mod->dict.size;
+  if (mod->dict.bucket)
+    mem->symbols += 2 * sizeof(int) * mod->dict.buckets;
+  if (mod->dict.symbols)
+    for (i = 0; i < mod->dict.count; i++)
+      mem->symbols += strsize(mod->dict.symbols[i].name, mod);
+
+  // Source line table and file name
+  mem->lines = 0;
+  if (mod->ltab.lines)
+    mem->lines = sizeof(vfm_line_t) * mod->ltab.size 
+      + strsize(mod->ltab.file, mod);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+int vfm_dump_memory(FILE* file, int header, vfm_mod_t *mod)
+{
+  if (!mod) return (vfm_errno = VFM_ERR);
+
+  vfm_mem_t mem;
+  int total;
+  
+  if (header)
+    fprintf(file, " module    code symbols   lines  counts   total\n");
+  vfm_memory(&mem, mod);
+  total = mem.module + mem.code + mem.symbols + mem.lines + mem.counters;
+  fprintf(file, "%7d %7d %7d %7d %7d %7d %s\n",
+	  mem.module, mem.code, mem.symbols, mem.lines, mem.counters,
+	  total, mod->name);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+int vfm_poison(vfm_env_t* env)
+{
+  if (!env) return (vfm_errno = VFM_ERR);
+
+  // Poison stacks; keep catch frame at bottom of return stack. The heap
+  // is zero filled for programs and its usage is the allocation pointer
+  memset(env->sp0, VFM_POISON, sizeof(vfm_data_t) * env->spsize);
+  if (env->rpsize > 1)
+    memset(env->rp0 + 1, VFM_POISON, sizeof(vfm_code_t*) * (env->rpsize - 1));
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+static int high_water(void* base, int size, int width)
+{
+  unsigned char* bp = (unsigned char*) base;
+  int n = (size > 0 ? size * width : 0);
+
+  while (n > 0 && bp[n - 1] == VFM_POISON) n--;
+  return ((n + width - 1) / width);
+}
+
+int vfm_high_water(vfm_env_t* env, int* data, int* ret, int* heap)
+{
+  if (!env || !env->sp0 || env->spsize < 2) return (vfm_errno = VFM_ERR);
+
+  // Not poisoned (vfm_poison) when the last data stack element is not
+  if (high_water(env->sp0 + env->spsize - 1, 1, sizeof(vfm_data_t)))
+    return (vfm_errno = VFM_ERR);
+
+  // Stacks grow upwards from the base; first element is not used
+  if (data) *data = high_water(env->sp0 + 1, env->spsize - 1, sizeof(vfm_data_t));
+  if (ret) *ret = high_water(env->rp0 + 1, env->rpsize - 1, sizeof(vfm_code_t*));
+  if (heap) *heap = (env->dp0 ? env->dp - env->dp0 : 0);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+int vfm_dump_env(FILE* file, vfm_env_t* env)
+{
+  int data;
+  int ret;
+  int heap;
+
+  if (vfm_high_water(env, &data, &ret, &heap)) return (vfm_errno);
+  fprintf(file, "   used    size\n");
+  fprintf(file, "%7d %7d data stack\n", data, env->spsize);
+  fprintf(file, "%7d %7d return stack\n", ret, env->rpsize);
+  fprintf(file, "%7d %7d heap\n", heap, env->dpsize);
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+// NB: Disassembler decodes the code of each symbol; from the symbol code
+// NB: address to the next symbol (index byte) or end of code segment.
+// NB: Instruction counters (profiling) are shown when non-zero.
+// NB: Code after UNSLIT (create and variable) is a data area, as are
+// NB: trailing bytes that do not hold a full operation.
+
+static char* symbname(vfm_code_t* addr, vfm_mod_t* mod)
+{
+  vfm_symb_t* symb;
+
+  if (!mod || addr < mod->segment.code 
+      || addr >= mod->segment.code + mod->segment.size) 
+    return ("?");
+  symb = vfm_addr2symb(addr, &mod->dict);
+  return (symb && symb->code == addr ? symb->name : "?");
+}
+
+static vfm_code_t* symbend(int i, vfm_mod_t* mod)
+{
+  vfm_symb_t* symb = mod->dict.symbols;
+  vfm_code_t* end = mod->segment.code + mod->segment.size;
+  int j;
+
+  for (j = 0; j < mod->dict.count; j++)
+    if (symb[j].code > symb[i].code && symb[j].code - 1 < end)
+      end = symb[j].code - 1;
+  return (end);
+}
+
+static int disasm(FILE* file, vfm_code_t* ip, vfm_code_t* end, 
+		  long long total, vfm_mod_t* mod)
+{
+  vfm_code_t* code = mod->segment.code;
+  vfm_code_t* tp;
+  int offset;
+  int op;
+  int n;
+  int i;
+
+  while (ip < end) {
+
+    // Write instruction counter and share of module total
+    offset = ip - code;
+    if (total) {
+      if (mod->segment.refcnt[offset])
+	fprintf(file, "%9lld %5.1f%% ", mod->segment.refcnt[offset],
+		mod->segment.refcnt[offset] * 100.0 / total);
+      else
+	fprintf(file, "%9s %6s ", "", "");
+    }
+    fprintf(file, "%5d: ", offset);
+
+    // Bytes that do not hold a full operation before the next symbol
+    // are data; skip to the code start of the next symbol
+    n = (*ip < 0 ? 1 : vfm_opsize(*ip));
+    if (n < 0) n = 1 + (ip + 1 < end ? (ip[1] & 0xff) : 0);
+    if (ip + 1 + n > end) {
+      fprintf(file, "%-8s %d bytes\n", "DATA", (int) (end - ip));
+      break;
+    }
+
+    // Implicit call; two byte relative offset
+    if (*ip < 0) {
+      n = (*ip << 8) | (ip[1] & 0xff);
+      tp = ip + 2 + n;
+      fprintf(file, "%-8s %s (%d)\n", 
+	      "NEST", symbname(tp, mod), (int) (tp - code));
+      ip += 2;
+      continue;
+    }
+
+    // Decode operation and operands
+    op = *ip;
+    fprintf(file, "%-8s", vfm_opname[op]);
+    switch (op) {
+    case VFM_OP_NNEST:
+      n = ip[1] & 0xff;
+      fprintf(file, " %d\n", n / 2);
+      for (i = 0; i + 1 < n; i += 2) {
+	tp = ip + 2 + i;
+	tp = tp + 2 + ((tp[0] << 8) | (tp[1] & 0xff));
+	if (total) fprintf(file, "%9s %6s ", "", "");
+	fprintf(file, "%5s  %8d %s (%d)\n", 
+		"", i / 2, symbname(tp, mod), (int) (tp - code));
+      }
+      ip += 2 + n;
+      continue;
+    case VFM_OP_SLIT:
+      n = ip[1] & 0xff;
+      fprintf(file, " \"");
+      for (i = 0; i < n && ip[2 + i]; i++)
+	fprintf(file, (ip[2 + i] >= ' ' && ip[2 + i] < 0x7f) ? "%c" : "\\%03o",
+		ip[2 + i] & 0xff);
+      fprintf(file, "\"\n");
+      ip += 2 + n;
+      continue;
+    case VFM_OP_MEST:
+      i = ip[1];
+      n = ((ip[2] << 8) | (ip[3] & 0xff));
+      if (i < mod->use.count && mod->use.mod)
+	fprintf(file, " %s::%s (%d)", mod->use.mod[i]->name,
+		symbname(mod->use.mod[i]->segment.code + n, mod->use.mod[i]), n);
+      else
+	fprintf(file, " %d %d", i, n);
+      break;
+    case VFM_OP_MESTI:
+      i = ip[1];
+      n = ip[2] & 0xff;
+      if (i < mod->use.count && mod->use.mod 
+	  && n < mod->use.mod[i]->dict.count)
+	fprintf(file, " %s::%s", mod->use.mod[i]->name,
+		mod->use.mod[i]->dict.symbols[n].name);
+      else
+	fprintf(file, " %d %d", i, n);
+      break;
+    case VFM_OP_BRA:
+    case VFM_OP_BRZE:
+    case VFM_OP_BRZN:
+    case VFM_OP_DBZN:
+    case VFM_OP_RBZN:
+    case VFM_OP_RDBG:
+    case VFM_OP_RBRI:
+    case VFM_OP_RBNE:
+    case VFM_OP_RDNE:
+    case VFM_OP_OVER_EQ_BRZE:
+    case VFM_OP_DUP_BRZE:
+      fprintf(file, " %d", (int) (ip + 2 + ip[1] - code));
+      break;
+    case VFM_OP_BRAX:
+    case VFM_OP_BRZX:
+    case VFM_OP_PLIT:
+      n = ((ip[1] << 8) | (ip[2] & 0xff));
+      fprintf(file, " %d", (int) (ip + 3 + n - code));
+      break;
+    case VFM_OP_LOCAL:
+      fprintf(file, " %d", ((ip[1] & 0xff) << 8) | (ip[2] & 0xff));
+      break;
+    case VFM_OP_CLIT:
+    case VFM_OP_CLIT_ADD:
+      fprintf(file, " %d", ip[1]);
+      break;
+    case VFM_OP_LIT:
+    case VFM_OP_UNLIT:
+    case VFM_OP_LIT_STORE:
+      n = ((ip[1] << 24) | ((ip[2] & 0xff) << 16) 
+	   | ((ip[3] & 0xff) << 8) | (ip[4] & 0xff));
+      fprintf(file, " %d", n);
+      break;
+    case VFM_OP_EXT0:
+    case VFM_OP_EXT1:
+    case VFM_OP_EXT2:
+    case VFM_OP_EXT3:
+      n = (op - VFM_OP_EXT0) << 8 | (ip[1] & 0xff);
+      fprintf(file, " %s", vfm_opname[n] ? vfm_opname[n] : "?");
+      break;
+    }
+    fprintf(file, "\n");
+    ip += 1 + vfm_opsize(op);
+
+    // Data area follows create and variable (UNSLIT)
+    if (op == VFM_OP_UNSLIT && ip < end) {
+      if (total) fprintf(file, "%9s %6s ", "", "");
+      fprintf(file, "%5d: %-8s %d bytes\n", (int) (ip - code), 
+	      "DATA", (int) (end - ip));
+      break;
+    }
+  }
+
+  return (0);
+}
+
+int vfm_disasm(FILE* file, char* entry, vfm_mod_t *mod)
+{
+  if (!mod) return (vfm_errno = VFM_ERR);
+
+  vfm_symb_t* symb = mod->dict.symbols;
+  long long total = 0;
+  int i;
+
+  // Total number of instruction counts for share
+  if (mod->segment.refcnt)
+    for (i = 0; i < mod->segment.size; i++)
+      total += mod->segment.refcnt[i];
+
+  // Decode symbols; end is the index byte of the following symbol
+  for (i = 0; i < mod->dict.count; i++) {
+    if (entry && strcmp(entry, symb[i].name)) continue;
+    fprintf(file, "%s::%s:\n", mod->name, symb[i].name);
+    disasm(file, symb[i].code, symbend(i, mod), total, mod);
+  }
+
+  return (vfm_errno = VFM_NOERR);
+}
+
+int vfm_opusage(int* count, vfm_mod_t *mod)
+{
+  if (!count || !mod) return (vfm_errno = VFM_ERR);
+
+  vfm_code_t* end;
+  vfm_code_t* ip;
+  int op;
+  int i;
+
+  // Decode symbols and count operations; implicit call is NEST
+  for (i = 0; i < mod->dict.count; i++) {
+    ip = mod->dict.symbols[i].code;
+    end = symbend(i, mod);
+    while (ip < end) {
+      if (*ip < 0) {
+	count[VFM_OP_NEST] += 1;
+	ip += 2;
+	continue;
+      }
+      op = *ip;
+      count[op] += 1;
+      if (op == VFM_OP_NNEST || op == VFM_OP_SLIT) {
+	ip += 2 + (ip[1] & 0xff);
+	continue;
+      }
+      if (op >= VFM_OP_EXT0 && op <= VFM_OP_EXT3) 
+	count[((op - VFM_OP_EXT0) << 8) | (ip[1] & 0xff)] += 1;
+      if (op == VFM_OP_UNSLIT) break;
+      ip += 1 + vfm_opsize(op);
+    }
+  }
+
+  return (vfm_errno = VFM_NOERR);
+}
+
 int vfm_lookup_module(char* fullname, vfm_symb_t** symb, vfm_mod_t *mod)
 {
   char* modulename = fullname;
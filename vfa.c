@@ -19,36 +19,91 @@
 #include <libgen.h>
 #include <string.h>
 #include <stdlib.h>
+#include <endian.h>
 
 // TODO: Options for add, remove and replace objects
 // TODO: Allow multiple versions of the same module in archive
 
-#define MOD_MAX 256
+// NB: Operation usage for modules and used modules; each module once
+
+static char** counted = 0;
+static int nr_counted = 0;
+static int max_counted = 0;
+static int opcount[VFM_OPMAX + 1];
+
+static void opusage(vfm_mod_t* mod)
+{
+  char** cp;
+  int i;
+
+  for (i = 0; i < nr_counted; i++)
+    if (!strcmp(counted[i], mod->name)) return;
+  if (nr_counted == max_counted) {
+    cp = (char**) realloc(counted, sizeof(char*) * (max_counted + 256));
+    if (!cp) return;
+    counted = cp;
+    max_counted += 256;
+  }
+  counted[nr_counted++] = mod->name;
+  vfm_opusage(opcount, mod);
+  for (i = 0; i < mod->use.count; i++)
+    opusage(mod->use.mod[i]);
+}
+
+static unsigned addstr(char* strings, unsigned* count, char* str)
+{
+  unsigned res = *count;
+
+  strcpy(strings + res, str);
+  *count += strlen(str) + 1;
+  return (htobe32(res));
+}
+
+static int cmp_opcount(const void* x, const void* y)
+{
+  int a = *(int*) x;
+  int b = *(int*) y;
+  if (opcount[a] != opcount[b]) return (opcount[b] - opcount[a]);
+  return (a - b);
+}
 
 int main(int argc, char* argv[])
 {
   FILE* infile;
   FILE* outfile;
-  vfm_map_t map[MOD_MAX];
+  vfm_map_t* map;
   vfm_arc_t arc;
-  vfm_mod_t mod[MOD_MAX];
+  vfm_mod_t* mod;
+  vfm_lib_t* lib;
+  vfm_member_t* member;
+  unsigned* bucket;
   char filename[FILENAME_MAX];
+  char tmpname[FILENAME_MAX + 4];
   char* archive;
   char* object;
   int debug = 1;
+  int strip = 0;
+  int stripsymbols = 0;
   int recursive = 0;
   int source = 0;
   int objects = 0;
   int opterr = 0;
   int listing = 0;
+  int memory = 0;
+  int ops = 0;
   int symbols = 0;
-  int pos;
+  unsigned strings;
+  unsigned buckets;
+  unsigned size;
+  unsigned h;
+  char* index;
+  long pos;
   int c;
   int i;
   int j;
 
   // Check options
-  while ((c = getopt(argc, argv, "clrs")) != EOF)
+  while ((c = getopt(argc, argv, "clmnorsx")) != EOF)
     switch (c) {
     case 'c':
       source = 1;
@@ -56,6 +111,15 @@ int main(int argc, char* argv[])
     case 'l':
       listing = 1;
       break;
+    case 'm':
+      memory = 1;
+      break;
+    case 'n':
+      strip = 1;
+      break;
+    case 'o':
+      ops = 1;
+      break;
     case 'r':
       recursive = 1;
       symbols = 1;
@@ -63,6 +127,9 @@ int main(int argc, char* argv[])
     case 's':
       symbols = 1;
       break;
+    case 'x':
+      stripsymbols = 1;
+      break;
     case '?':
     default:
       opterr = 1;
@@ -70,20 +137,26 @@ int main(int argc, char* argv[])
 
   // Check parameters
   if (optind == argc || opterr) {
-    fprintf(stderr, "usage: vfa [-clrs] archive object...\n");
+    fprintf(stderr, "usage: vfa [-clmnorsx] archive object...\n");
     fprintf(stderr, "vfm object code archiver\n");
     fprintf(stderr, "  -c	generate c source code, file.i\n");
     fprintf(stderr, "  -l	list archive object modules\n");
+    fprintf(stderr, "  -m	report memory usage for loaded object modules\n");
+    fprintf(stderr, "  -n	strip source line tables from object files\n");
+    fprintf(stderr, "  -o	list operations used by object modules, most used first\n");
     fprintf(stderr, "  -r	list all symbols for object file(s)\n");
     fprintf(stderr, "  -s	list symbols for object file(s)\n");
+    fprintf(stderr, "  -x	strip symbol and source line tables from object files\n");
     return (-1);
   }
 
   // Check for archive file name and number of object files
   archive = argv[optind++];
   objects = argc - optind;
-  if (objects > MOD_MAX) {
-    fprintf(stderr, "error: number of files exceeded (max %d)\n", MOD_MAX);
+  mod = (vfm_mod_t*) calloc(objects + 1, sizeof(vfm_mod_t));
+  map = (vfm_map_t*) calloc(objects + 1, sizeof(vfm_map_t));
+  if (!mod || !map) {
+    fprintf(stderr, "error: out of memory\n");
     return (-1);
   }
 
@@ -96,13 +169,62 @@ int main(int argc, char* argv[])
       return (-1);
     }
     for (i = 0; i < arc.count; i++) {
+      vfm_arc_member(&arc, i, &map[0]);
       printf("%7d %5d %.19s %s %s %s\n", 
-	     arc.map[i].pos, 
-	     arc.map[i].size, 
-	     ctime(&arc.map[i].timestamp),
-	     arc.map[i].name,
-	     arc.map[i].ident,
-	     arc.map[i].version);
+	     map[0].pos, 
+	     map[0].size, 
+	     ctime(&map[0].timestamp),
+	     map[0].name,
+	     map[0].ident,
+	     map[0].version);
+    }
+    vfm_arc_close(&arc);
+    fclose(infile);
+    return (0);
+  }
+
+  // Check for operation usage; all object modules when none given
+  if (ops) {
+    int opcode[VFM_OPMAX + 1];
+    infile = vfm_fopen_arc_file(archive);
+    if (!infile || vfm_arc_map_load(infile, &arc)) {
+      fprintf(stderr, "%s: error: unknown or illegal archive file\n", archive);
+      return (-1);
+    }
+    vfm_init();
+    if (!objects) mod = (vfm_mod_t*) calloc(arc.count + 1, sizeof(vfm_mod_t));
+    for (i = 0; mod && i < (objects ? objects : arc.count); i++) {
+      vfm_arc_member(&arc, i, &map[0]);
+      object = (objects ? argv[optind + i] : map[0].name);
+      if (vfm_arc_load(infile, object, debug, &mod[i], &arc)) {
+	fprintf(stderr, "%s: not in archive file\n", object);
+	return (-1);
+      }
+      opusage(&mod[i]);
+    }
+    fclose(infile);
+    for (i = 0; i <= VFM_OPMAX; i++) opcode[i] = i;
+    qsort(opcode, VFM_OPMAX + 1, sizeof(int), cmp_opcount);
+    for (i = 0; i <= VFM_OPMAX && opcount[opcode[i]]; i++)
+      printf("%7d %s\n", opcount[opcode[i]], vfm_opname[opcode[i]]);
+    return (0);
+  }
+
+  // Check for memory usage report; all object modules when none given
+  if (memory) {
+    infile = vfm_fopen_arc_file(archive);
+    if (!infile || vfm_arc_map_load(infile, &arc)) {
+      fprintf(stderr, "%s: error: unknown or illegal archive file\n", archive);
+      return (-1);
+    }
+    for (i = 0; i < (objects ? objects : arc.count); i++) {
+      vfm_arc_member(&arc, i, &map[0]);
+      object = (objects ? argv[optind + i] : map[0].name);
+      if (vfm_arc_load(infile, object, debug, &mod[0], &arc)) {
+	fprintf(stderr, "%s: not in archive file\n", object);
+	return (-1);
+      }
+      vfm_dump_memory(stdout, i == 0, &mod[0]);
     }
     fclose(infile);
     return (0);
@@ -131,8 +253,6 @@ int main(int argc, char* argv[])
   }
 
   // Normal mode: Load object files and collect file size
-  arc.size = arc.count = objects;
-  arc.map = map;
   for (j = 0, i = optind; i < argc; i++, j++) {
     object = argv[i];
     infile = vfm_fopen_obj_file(object);
@@ -140,45 +260,95 @@ int main(int argc, char* argv[])
       fprintf(stderr, "%s: error: unknown or illegal object file\n", object);
       return (-1);
     }
-    fseek(infile, 0, SEEK_END);
-    arc.map[j].size = ftell(infile);
-    arc.map[j].name = mod[j].name;
-    arc.map[j].timestamp = mod[j].timestamp;
-    arc.map[j].ident = mod[j].ident;
-    arc.map[j].version = mod[j].version;
     fclose(infile);
+
+    // Object file size as stored in archive; possibly stripped
+    if (strip || stripsymbols) mod[j].ltab.count = 0;
+    if (stripsymbols) mod[j].dict.count = 0;
+    infile = tmpfile();
+    if (!infile) {
+      fprintf(stderr, "error: could not create temporary file\n");
+      return (-1);
+    }
+    vfm_store(infile, &mod[j]);
+    map[j].size = ftell(infile);
+    map[j].name = mod[j].name;
+    map[j].timestamp = mod[j].timestamp;
+    map[j].ident = mod[j].ident;
+    map[j].version = mod[j].version;
+    fclose(infile);
+  }
+
+  // Archive header, member and bucket tables, and strings
+  for (buckets = 1; buckets < objects; buckets *= 2);
+  strings = 0;
+  for (i = 0; i < objects; i++)
+    strings += strlen(map[i].name) + strlen(map[i].ident) 
+      + strlen(map[i].version) + 3;
+  size = sizeof(vfm_lib_t) + sizeof(vfm_member_t) * objects 
+    + sizeof(unsigned) * buckets + strings;
+  index = (char*) calloc(1, size);
+  if (!index) {
+    fprintf(stderr, "error: out of memory\n");
+    return (-1);
   }
+  lib = (vfm_lib_t*) index;
+  member = (vfm_member_t*) (index + sizeof(vfm_lib_t));
+  bucket = (unsigned*) (member + objects);
+  strncpy(lib->magic, VFM_LIB_MAGIC, sizeof(lib->magic));
+  lib->count = htobe32(objects);
+  lib->buckets = htobe32(buckets);
+  lib->member = htobe32((char*) member - index);
+  lib->bucket = htobe32((char*) bucket - index);
+  lib->strings = htobe32((char*) (bucket + buckets) - index);
+  lib->size = htobe32(size);
 
-  // Generate relative position in archive 
-  pos = 0;
+  // Object files are page aligned in the archive file so that they are
+  // mapped exactly; after the header and tables
+  strings = 0;
+  pos = size;
   for (i = 0; i < objects; i++) {
-    arc.map[i].pos = pos;
-    pos = pos + arc.map[i].size;
+    pos = (pos + VFM_ARC_ALIGN - 1) & ~(VFM_ARC_ALIGN - 1);
+    map[i].pos = pos;
+    member[i].name = addstr((char*) (bucket + buckets), &strings, map[i].name);
+    member[i].ident = addstr((char*) (bucket + buckets), &strings, map[i].ident);
+    member[i].version = addstr((char*) (bucket + buckets), &strings, map[i].version);
+    member[i].timestamp = htobe32(map[i].timestamp);
+    member[i].size = htobe32(map[i].size);
+    member[i].pos = htobe32(map[i].pos);
+    pos = pos + map[i].size;
   }
 
-  // Write archive header
+  // Name index; chained in reverse so that the first of a name is found
+  for (i = objects - 1; i >= 0; i--) {
+    h = vfm_strhash(map[i].name) & (buckets - 1);
+    member[i].next = bucket[h];
+    bucket[h] = htobe32(i + 1);
+  }
+
+  // Write archive header and tables to a temporary file; replaced with
+  // rename so that readers with the archive mapped keep the old file
   sprintf(filename, "%s.vfa", archive);
-  outfile = fopen(filename, "w");
+  sprintf(tmpname, "%s.tmp", filename);
+  outfile = fopen(tmpname, "w");
   if (!outfile) {
     fprintf(stderr, "%s: error: could not create archive file\n", filename);
     return (-1);
   }
-  fputs(VFM_LIB_MAGIC, outfile);
-  fputint(objects, outfile);
-  for (i = 0; i < objects; i++) {
-    fputstr(arc.map[i].name, outfile);
-    fputstr(arc.map[i].ident, outfile);
-    fputstr(arc.map[i].version, outfile);
-    fputint(arc.map[i].timestamp, outfile);
-    fputint(arc.map[i].size, outfile);
-    fputint(arc.map[i].pos, outfile);
-  }
-  arc.pos = ftell(outfile);
+  fwrite(index, 1, size, outfile);
+  free(index);
 
-  // Store object files in sequence - the simple solution
+  // Store object files in sequence; padding to aligned position is a
+  // hole in the file (reads as zero) as the alignment is large
   for (i = 0; i < objects; i++) {
+    fseek(outfile, map[i].pos, SEEK_SET);
     vfm_store(outfile, &mod[i]);
   }
+  if (fclose(outfile) || rename(tmpname, filename)) {
+    remove(tmpname);
+    fprintf(stderr, "%s: error: could not create archive file\n", filename);
+    return (-1);
+  }
 
   return (0);
 }
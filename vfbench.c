@@ -0,0 +1,242 @@
+/* Copyright 2009, Mikael Patel
+   This file is part of vfm, virtual forth machine project.
+ 
+   vfm is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+ 
+   vfm is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+ 
+   You should have received a copy of the GNU General Public License
+   along with vfm.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include "vfm.h"
+#include <unistd.h>
+#include <string.h>
+#include <stdlib.h>
+
+// NB: Manifest lines; name object entry [samples] [mode]. Lines
+// NB: starting with '#' are comments. Objects are loaded once. Modes
+// NB: are profile, coverage and profile-coverage (run with profiling)
+// NB: and nosymbols (object loaded without symbols, the object entry
+// NB: is run).
+
+#define BENCH_MAX 256
+#define MOD_MAX 64
+#define STRING_MAX 256
+
+#define RETURN_STACK_SIZE 128
+#define DATA_STACK_SIZE 256
+#define DATA_HEAP_SIZE 32 * 1024
+
+static vfm_mod_t mods[MOD_MAX];
+static int debugs[MOD_MAX];
+static int nr_mods = 0;
+
+static vfm_mod_t* load(char* object, int debug)
+{
+  FILE* file;
+  int i;
+
+  for (i = 0; i < nr_mods; i++)
+    if (!strcmp(mods[i].name, object) && debugs[i] == debug) 
+      return (&mods[i]);
+  if (nr_mods == MOD_MAX) return (0);
+  file = vfm_fopen_obj_file(object);
+  if (!file || vfm_load(file, debug, &mods[nr_mods])) return (0);
+  fclose(file);
+  debugs[nr_mods] = debug;
+  return (&mods[nr_mods++]);
+}
+
+// NB: Cost table; benchmarks with an empty loop (name.empty) less the
+// NB: empty loop and divided by the number of iterations per run
+
+static void cost(FILE* file, vfm_bench_t* bench, int count, int iterations)
+{
+  char name[STRING_MAX];
+  vfm_bench_t* empty;
+  int i;
+  int j;
+
+  fprintf(file, "%10s %10s %10s %s\n", "ns", "cycles", "dispatches", "name");
+  for (i = 0; i < count; i++) {
+    snprintf(name, sizeof(name), "%s.empty", bench[i].name);
+    for (empty = 0, j = 0; j < count && !empty; j++)
+      if (!strcmp(bench[j].name, name)) empty = &bench[j];
+    if (!empty) continue;
+    fprintf(file, "%10.2f ", 
+	    (bench[i].median - empty->median) / iterations);
+    if (bench[i].perf[VFM_PERF_CYCLES] < 0 || empty->perf[VFM_PERF_CYCLES] < 0)
+      fprintf(file, "%10s ", "-");
+    else
+      fprintf(file, "%10.2f ", 
+	      (bench[i].perf[VFM_PERF_CYCLES] - empty->perf[VFM_PERF_CYCLES]) 
+	      / iterations);
+    fprintf(file, "%10.2f %s\n", 
+	    (double) (bench[i].dispatches - empty->dispatches) / iterations,
+	    bench[i].name);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  FILE* file;
+  vfm_env_t env;
+  vfm_bench_t bench[BENCH_MAX];
+  vfm_code_t catch[] = { VFM_OP_HALT };
+  vfm_code_t* rp0[RETURN_STACK_SIZE] = { catch };
+  vfm_data_t sp0[DATA_STACK_SIZE];
+  vfm_data_t dp0[DATA_HEAP_SIZE];
+  char line[STRING_MAX * 4];
+  char name[STRING_MAX];
+  char object[STRING_MAX];
+  char entry[STRING_MAX];
+  char mode[STRING_MAX];
+  vfm_code_t* ip;
+  vfm_mod_t* mod;
+  char* baseline = 0;
+  char* output = 0;
+  double threshold = 10.0;
+  int iterations = 0;
+  int samples = 100;
+  int warmup = 3;
+  int regressions = 0;
+  int count = 0;
+  int runs;
+  int opterr = 0;
+  int n;
+  int c;
+
+  // Check options
+  while ((c = getopt(argc, argv, "b:c:o:s:t:w:")) != EOF)
+    switch (c) {
+    case 'b':
+      baseline = optarg;
+      break;
+    case 'c':
+      iterations = atoi(optarg);
+      if (iterations <= 0) opterr = 1;
+      break;
+    case 'o':
+      output = optarg;
+      break;
+    case 's':
+      samples = atoi(optarg);
+      break;
+    case 't':
+      threshold = atof(optarg);
+      break;
+    case 'w':
+      warmup = atoi(optarg);
+      break;
+    case '?':
+    default:
+      opterr = 1;
+    }
+
+  // Check parameters
+  if ((argc != optind + 1) || opterr || samples <= 0 || warmup < 0) {
+    fprintf(stderr, "usage: vfbench [-b baseline][-c iterations][-o file][-s samples][-t threshold][-w warmup] manifest\n");
+    fprintf(stderr, "vfm benchmark tool\n");
+    fprintf(stderr, "  -b	compare with baseline (saved result)\n");
+    fprintf(stderr, "  -c	cost table; iterations per run (name.empty)\n");
+    fprintf(stderr, "  -o	write result to file (default stdout)\n");
+    fprintf(stderr, "  -s	number of samples (default 100)\n");
+    fprintf(stderr, "  -t	regression threshold in percent (default 10)\n");
+    fprintf(stderr, "  -w	number of warm-up samples (default 3)\n");
+    return (-1);
+  }
+
+  // Initiate run-time and read manifest
+  vfm_init();
+  file = fopen(argv[optind], "r");
+  if (!file) {
+    fprintf(stderr, "%s: error: unknown manifest file\n", argv[optind]);
+    return (-1);
+  }
+  while (fgets(line, sizeof(line), file)) {
+    if (*line == '#') continue;
+    *mode = 0;
+    n = sscanf(line, "%255s %255s %255s %d %255s", 
+	       name, object, entry, &runs, mode);
+    if (n <= 0) continue;
+    if (n < 3 || count == BENCH_MAX
+	|| (*mode && strcmp(mode, "profile") && strcmp(mode, "coverage")
+	    && strcmp(mode, "profile-coverage") && strcmp(mode, "nosymbols"))) {
+      fprintf(stderr, "%s: error: illegal manifest line\n", argv[optind]);
+      return (-1);
+    }
+
+    // Load object and lookup entry symbol; object entry without symbols
+    mod = load(object, strcmp(mode, "nosymbols") != 0);
+    if (!mod) {
+      fprintf(stderr, "%s: error: unknown or illegal object file\n", object);
+      return (-1);
+    }
+    if (!strcmp(mode, "nosymbols"))
+      ip = mod->segment.entry;
+    else {
+      vfm_symb_t* symb = vfm_name2symb(entry, &mod->dict);
+      ip = (symb ? symb->code : 0);
+    }
+    if (!ip) {
+      fprintf(stderr, "%s: error: unknown entry\n", entry);
+      return (-1);
+    }
+
+    // Run benchmark
+    bench[count].name = strdup(name);
+    bench[count].warmup = warmup;
+    bench[count].samples = (n < 4 ? samples : runs);
+    bench[count].baseline = 0.0;
+    bench[count].regression = 0;
+    env.status = ((*mode && strcmp(mode, "nosymbols")) ? 
+		  VFM_PROFILING_STATUS : VFM_NORMAL_STATUS);
+    env.sp = env.sp0 = sp0; 
+    env.rp = env.rp0 = rp0; 
+    env.dp = env.dp0 = dp0; 
+    env.spsize = DATA_STACK_SIZE;
+    env.rpsize = RETURN_STACK_SIZE;
+    env.dpsize = DATA_HEAP_SIZE;
+    env.mp = mod; 
+    env.ip = ip;
+    if (vfm_bench_run(&bench[count], &env)) {
+      fprintf(stderr, "%s: error: benchmark failed\n", name);
+      return (-1);
+    }
+    count += 1;
+  }
+  fclose(file);
+
+  // Compare with baseline
+  if (baseline) {
+    file = fopen(baseline, "r");
+    if (!file) {
+      fprintf(stderr, "%s: error: unknown baseline file\n", baseline);
+      return (-1);
+    }
+    regressions = vfm_bench_baseline(file, bench, count, threshold);
+    fclose(file);
+  }
+
+  // Write result; cost table replaces result on stdout
+  if (iterations) cost(stdout, bench, count, iterations);
+  if (output || !iterations) {
+    file = (output ? fopen(output, "w") : stdout);
+    if (!file) {
+      fprintf(stderr, "%s: error: could not create result file\n", output);
+      return (-1);
+    }
+    vfm_bench_store(file, bench, count);
+    if (output) fclose(file);
+  }
+  if (regressions)
+    fprintf(stderr, "warning: %d regression(s)\n", regressions);
+
+  return (regressions != 0);
+}
@@ -0,0 +1,93 @@
+/* Copyright 2009, Mikael Patel
+   This file is part of vfm, virtual forth machine project.
+ 
+   vfm is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+ 
+   vfm is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+ 
+   You should have received a copy of the GNU General Public License
+   along with vfm.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include "vfm.h"
+#include <string.h>
+
+// NB: Standalone executable; archive and entry are given when compiling
+// NB: (makefile: BUNDLE_ARCHIVE and BUNDLE_ENTRY). The archive is embedded
+// NB: in a data section and its members are loaded in place (vfm_arc_init).
+// NB: The section is writable as variables are in the code of the modules.
+
+#if !defined(BUNDLE_ARCHIVE) || !defined(BUNDLE_ENTRY)
+# error "bundle archive and entry must be defined"
+#endif
+
+#define RETURN_STACK_SIZE 128
+#define DATA_STACK_SIZE 256
+#define DATA_HEAP_SIZE 32 * 1024
+
+// NB: Members are aligned as in the archive file (VFM_ARC_ALIGN)
+
+#define STR(x) #x
+#define XSTR(x) STR(x)
+
+asm(".section .data.vfm,\"aw\",@progbits\n"
+    ".balign " XSTR(VFM_ARC_ALIGN) "\n"
+    ".global vfm_bundle\n"
+    "vfm_bundle:\n"
+    ".incbin \"" BUNDLE_ARCHIVE "\"\n"
+    ".global vfm_bundle_end\n"
+    "vfm_bundle_end:\n"
+    ".previous\n");
+
+extern char vfm_bundle[];
+extern char vfm_bundle_end[];
+
+int main(int argc, char* argv[])
+{
+  vfm_env_t env;
+  vfm_arc_t arc;
+  vfm_mod_t mod;
+  vfm_symb_t* symb;
+  vfm_code_t catch[] = { VFM_OP_HALT };
+  vfm_code_t* rp0[RETURN_STACK_SIZE] = { catch };
+  vfm_data_t sp0[DATA_STACK_SIZE];
+  vfm_data_t dp0[DATA_HEAP_SIZE];
+  char modulename[] = BUNDLE_ENTRY;
+  char* entryname;
+
+  // Initiate run-time and open embedded archive
+  vfm_init();
+  if (vfm_arc_init(&arc, vfm_bundle, vfm_bundle_end - vfm_bundle)) {
+    fprintf(stderr, "%s: error: illegal bundle archive\n", argv[0]);
+    return (-1);
+  }
+
+  // Load entry module and used modules from archive
+  entryname = vfm_parse_entry(modulename);
+  if (!entryname || vfm_arc_load(0, modulename, 1, &mod, &arc)) {
+    fprintf(stderr, "%s: error: failed to load\n", modulename);
+    return (-1);
+  }
+  symb = vfm_name2symb(entryname, &mod.dict);
+  if (!symb) {
+    fprintf(stderr, "%s: error: unknown entry\n", entryname);
+    return (-1);
+  }
+
+  // Run entry
+  env.status = VFM_NORMAL_STATUS;
+  env.sp = env.sp0 = sp0; 
+  env.rp = env.rp0 = rp0; 
+  env.dp = env.dp0 = dp0; 
+  env.spsize = DATA_STACK_SIZE;
+  env.rpsize = RETURN_STACK_SIZE;
+  env.dpsize = DATA_HEAP_SIZE;
+  env.mp = &mod; 
+  env.ip = symb->code;
+  return (vfm_run(&env));
+}
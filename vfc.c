@@ -28,10 +28,13 @@ int main(int argc, char* argv[])
   FILE* infile;
   FILE* outfile;
   char filename[FILENAME_MAX];
+  char tmpname[FILENAME_MAX + 4];
   vfm_mod_t mod;
   char* entry = "main";
   int coverage = 0;
   int profile = 0;
+  int debug = 0;
+  int strip = 0;
   int object = 1;
   int source = 0;
   int opterr = 0;
@@ -40,7 +43,7 @@ int main(int argc, char* argv[])
   int i;
 
   // Check options
-  while ((c = getopt(argc, argv, "ce:ops")) != EOF)
+  while ((c = getopt(argc, argv, "ce:gopsx")) != EOF)
     switch (c) {
     case 'c':
       coverage = 1;
@@ -48,6 +51,9 @@ int main(int argc, char* argv[])
     case 'e':
       entry = optarg;
       break;
+    case 'g':
+      debug = 1;
+      break;
     case 'o':
       object = 1;
       break;
@@ -57,6 +63,9 @@ int main(int argc, char* argv[])
     case 's':
       source = 1;
       break;
+    case 'x':
+      strip = 1;
+      break;
     case '?':
     default:
       opterr = 1;
@@ -64,13 +73,15 @@ int main(int argc, char* argv[])
 
   // Check parameters
   if (optind == argc || opterr) {
-    fprintf(stderr, "usage: vfc [-cops][-e entry] file\n");
+    fprintf(stderr, "usage: vfc [-cgopsx][-e entry] file\n");
     fprintf(stderr, "vfm compiler and static analysis tool\n");
     fprintf(stderr, "  -c	static code coverage\n");
     fprintf(stderr, "  -e	define entry (default main)\n");
+    fprintf(stderr, "  -g	generate source line table (debug)\n");
     fprintf(stderr, "  -o	generate object code, package/file.vfm\n");
     fprintf(stderr, "  -p	static code usage profile\n");
     fprintf(stderr, "  -s	generate c source code, package/file.i\n");
+    fprintf(stderr, "  -x	strip symbol table from object code (run only)\n");
     return (-1);
   }
 
@@ -93,6 +104,7 @@ int main(int argc, char* argv[])
       return (-1);
     }
     fclose(infile);
+    if (!debug) mod.ltab.count = 0;
 
     // Static analysis, add header for multiple files
     if ((files > 1) && (profile || coverage)) 
@@ -116,18 +128,26 @@ int main(int argc, char* argv[])
       fclose(outfile);
     } 
 
-    // Generate object code
+    // Generate object code; written as a new file and renamed as
+    // object files are memory mapped when loaded. Stripped object code
+    // can be run but not used when compiling
     if (object) {
+      if (strip) mod.dict.count = mod.ltab.count = 0;
       strcpy(filename, mod.name);
       vfm_name2path(filename);
       strcat(filename, ".vfm");
-      outfile = fopen(filename, "w");
+      sprintf(tmpname, "%s.tmp", filename);
+      outfile = fopen(tmpname, "w");
       if (!outfile) {
 	fprintf(stderr, "%s: error: could not create object file\n", filename);
 	return (-1);
       }
       vfm_store(outfile, &mod);
       fclose(outfile);
+      if (rename(tmpname, filename)) {
+	fprintf(stderr, "%s: error: could not create object file\n", filename);
+	return (-1);
+      }
     }
   }
   return (0);
@@ -0,0 +1,107 @@
+/* Copyright 2009, Mikael Patel
+   This file is part of vfm, virtual forth machine project.
+ 
+   vfm is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+ 
+   vfm is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+ 
+   You should have received a copy of the GNU General Public License
+   along with vfm.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include "vfm.h"
+#include <unistd.h>
+#include <stdlib.h>
+
+int main(int argc, char* argv[])
+{
+  FILE* file;
+  vfm_arc_t arc;
+  vfm_mod_t mod;
+  char* entryname = 0;
+  char* archive = 0;
+  char* profile = 0;
+  char* object;
+  int recursive = 0;
+  int opterr = 0;
+  int c;
+  int i;
+
+  // Check options
+  while ((c = getopt(argc, argv, "e:l:p:r")) != EOF)
+    switch (c) {
+    case 'e':
+      entryname = optarg;
+      break;
+    case 'l':
+      archive = optarg;
+      break;
+    case 'p':
+      profile = optarg;
+      break;
+    case 'r':
+      recursive = 1;
+      break;
+    case '?':
+    default:
+      opterr = 1;
+    }
+
+  // Check parameters
+  if ((argc != optind + 1) || opterr) {
+    fprintf(stderr, "usage: vfdis [-r][-e entry][-l library][-p profile] object\n");
+    fprintf(stderr, "vfm object code disassembler\n");
+    fprintf(stderr, "  -e	disassemble symbol only\n");
+    fprintf(stderr, "  -l	load object code files from library\n");
+    fprintf(stderr, "  -p	annotate with instruction counts from profile (vfm -w)\n");
+    fprintf(stderr, "  -r	disassemble used modules\n");
+    return (-1);
+  }
+
+  // Initiate run-time; operation names
+  vfm_init();
+
+  // Load object file or module from library with symbols
+  object = argv[optind];
+  if (archive) {
+    file = vfm_fopen_arc_file(archive);
+    if (!file || vfm_arc_map_load(file, &arc)) {
+      fprintf(stderr, "%s: error: unknown or illegal archive file\n", archive);
+      return (-1);
+    }
+    if (vfm_arc_load(file, object, 1, &mod, &arc)) {
+      fprintf(stderr, "%s: error: failed to load\n", object);
+      return (-1);
+    }
+  } else {
+    file = vfm_fopen_obj_file(object);
+    if (!file || vfm_load(file, 1, &mod)) {
+      fprintf(stderr, "%s: error: unknown or illegal object file\n", object);
+      return (-1);
+    }
+  }
+  fclose(file);
+
+  // Load instruction counters from binary profile
+  if (profile) {
+    file = fopen(profile, "r");
+    if (!file || vfm_profile_load(file, &mod)) {
+      fprintf(stderr, "%s: error: unknown or illegal profile file\n", profile);
+      return (-1);
+    }
+    fclose(file);
+  }
+
+  // Disassemble module and used modules
+  vfm_disasm(stdout, entryname, &mod);
+  if (recursive)
+    for (i = 0; i < mod.use.count; i++)
+      vfm_disasm(stdout, entryname, mod.use.mod[i]);
+
+  return (0);
+}
@@ -18,6 +18,10 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/time.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
 
 // TODO: Allow stack size as option
 
@@ -25,6 +29,186 @@
 #define DATA_STACK_SIZE 256
 #define DATA_HEAP_SIZE 32 * 1024
 
+// NB: Signals are posted as requests to the running environment;
+// NB: SIGUSR1 writes a metrics snapshot and SIGUSR2 toggles profiling
+
+static void request_handler(int sig)
+{
+  __sync_fetch_and_or(&vfm_request, 
+		      sig == SIGUSR1 ? VFM_SNAPSHOT_REQUEST : VFM_PROFILE_REQUEST);
+}
+
+// NB: Scaling benchmark; the entry is run on a number of threads, each
+// NB: with its own environment and stacks, against the shared module.
+// NB: Thread blocks are cache line aligned so that the tool itself adds
+// NB: no false sharing; shared module data is what is measured. Threads
+// NB: wait on a start gate that is opened when all are created, or
+// NB: cancelled when a thread cannot be created. Task accounting in the
+// NB: run-time (vfm_tasks) is atomic and shared by the threads.
+
+#define CACHE_LINE_SIZE 64
+
+typedef struct thread_t {
+  pthread_t id;
+  vfm_env_t env;
+  vfm_mod_t* mod;
+  vfm_code_t* rp0[RETURN_STACK_SIZE];
+  vfm_data_t sp0[DATA_STACK_SIZE];
+  vfm_data_t dp0[DATA_HEAP_SIZE];
+  double* time;
+  int times;
+  int err;
+} thread_t;
+
+static vfm_code_t halt[] = { VFM_OP_HALT };
+static pthread_mutex_t gate_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t gate_cond = PTHREAD_COND_INITIALIZER;
+static int gate = 0;
+
+static void gate_set(int state)
+{
+  pthread_mutex_lock(&gate_lock);
+  gate = state;
+  pthread_cond_broadcast(&gate_cond);
+  pthread_mutex_unlock(&gate_lock);
+}
+
+static double now()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static int cmp_double(const void* x, const void* y)
+{
+  double a = *(double*) x;
+  double b = *(double*) y;
+  return (a < b ? -1 : a > b);
+}
+
+static void* thread_run(void* arg)
+{
+  thread_t* tp = (thread_t*) arg;
+  double start;
+  int i;
+
+  // Wait for start; no runs when cancelled
+  pthread_mutex_lock(&gate_lock);
+  while (!gate) pthread_cond_wait(&gate_cond, &gate_lock);
+  pthread_mutex_unlock(&gate_lock);
+  if (gate < 0) {
+    tp->times = 0;
+    return (0);
+  }
+  for (i = 0; i < tp->times; i++) {
+    start = now();
+    tp->env.status = VFM_NORMAL_STATUS;
+    tp->env.sp = tp->env.sp0 = tp->sp0; 
+    tp->env.rp = tp->env.rp0 = tp->rp0; 
+    tp->env.dp = tp->env.dp0 = tp->dp0; 
+    tp->env.spsize = DATA_STACK_SIZE;
+    tp->env.rpsize = RETURN_STACK_SIZE;
+    tp->env.dpsize = DATA_HEAP_SIZE;
+    tp->env.mp = tp->mod; 
+    tp->env.ip = tp->mod->segment.entry;
+    tp->err = vfm_run(&tp->env);
+    tp->time[i] = now() - start;
+    if (tp->err) {
+      tp->times = i + 1;
+      break;
+    }
+  }
+  return (0);
+}
+
+static void release_threads(thread_t** tp, int threads)
+{
+  int i;
+
+  for (i = 0; i < threads; i++)
+    if (tp[i]) {
+      free(tp[i]->time);
+      free(tp[i]);
+    }
+  free(tp);
+}
+
+static int run_threads(vfm_mod_t* mod, int threads, int times)
+{
+  thread_t** tp;
+  double start;
+  double stop;
+  int created;
+  int runs = 0;
+  int res = 0;
+  int n;
+  int i;
+
+  // Allocate thread blocks and latency samples
+  tp = (thread_t**) calloc(threads, sizeof(thread_t*));
+  if (!tp) return (VFM_MALLOC_ERR);
+  for (i = 0; i < threads; i++) {
+    if (posix_memalign((void**) &tp[i], CACHE_LINE_SIZE, sizeof(thread_t))) {
+      tp[i] = 0;
+      release_threads(tp, threads);
+      return (VFM_MALLOC_ERR);
+    }
+    memset(tp[i], 0, sizeof(thread_t));
+    tp[i]->mod = mod;
+    tp[i]->rp0[0] = halt;
+    tp[i]->times = times;
+    tp[i]->time = (double*) calloc(times, sizeof(double));
+    if (!tp[i]->time) {
+      release_threads(tp, threads);
+      return (VFM_MALLOC_ERR);
+    }
+  }
+
+  // Create threads; cancel and join those started when one fails
+  gate = 0;
+  for (created = 0; created < threads; created++)
+    if (pthread_create(&tp[created]->id, NULL, thread_run, tp[created]))
+      break;
+  if (created < threads) {
+    fprintf(stderr, "error: could not create thread\n");
+    gate_set(-1);
+    for (i = 0; i < created; i++)
+      pthread_join(tp[i]->id, NULL);
+    release_threads(tp, threads);
+    return (VFM_ERR);
+  }
+
+  // Start threads together and measure wall time until all are done
+  start = now();
+  gate_set(1);
+  for (i = 0; i < threads; i++)
+    pthread_join(tp[i]->id, NULL);
+  stop = now();
+
+  // Report per-thread latency and aggregate throughput
+  printf("%6s %10s %12s %12s %12s\n", 
+	 "thread", "runs", "median(us)", "p99(us)", "max(us)");
+  for (i = 0; i < threads; i++) {
+    n = tp[i]->times;
+    runs += n;
+    qsort(tp[i]->time, n, sizeof(double), cmp_double);
+    printf("%6d %10d %12.2f %12.2f %12.2f\n", i, n,
+	   tp[i]->time[n / 2] / 1000.0,
+	   tp[i]->time[(n * 99) / 100] / 1000.0,
+	   tp[i]->time[n - 1] / 1000.0);
+    if (tp[i]->err) {
+      fprintf(stderr, "error: thread %d: run failed (%d)\n", i, tp[i]->err);
+      if (!res) res = tp[i]->err;
+    }
+  }
+  printf("%d threads, %d runs, %.f ms, %.1f runs/s\n", 
+	 threads, runs, (stop - start) / 1e6, runs * 1e9 / (stop - start));
+  release_threads(tp, threads);
+  return (res ? VFM_ERR : VFM_NOERR);
+}
+
 int main(int argc, char* argv[])
 {
   FILE* file;
@@ -38,21 +222,35 @@ int main(int argc, char* argv[])
   int status = VFM_NORMAL_STATUS;
   char* modulename = 0;
   char* entryname = 0;
+  char* initname = 0;
   char* archive = 0;
   char* object = 0;
   int benchmark = 0;
   int coverage = 0;
   int profile = 0;
+  int ngram = 0;
+  int lines = 0;
+  int usage = 0;
+  int counters = 0;
+  vfm_perf_t perf;
+  char* lcov = 0;
+  char* output = 0;
+  char* image = 0;
+  char* save = 0;
+  vfm_code_t* init = 0;
+  vfm_data_t* heap = 0;
+  int heapsize = 0;
   int debug = 1;
   int recursive = 0;
   int symbols = 0;
   int opterr = 0;
   int times = 1;
+  int threads = 0;
   int errno;
   int c;
 
   // Check options
-  while ((c = getopt(argc, argv, "b:cde:l:npsrt")) != EOF)
+  while ((c = getopt(argc, argv, "b:cde:g:Hi:I:j:l:Lm:no:psrS:tuw:z")) != EOF)
     switch (c) {
     case 'b':
       benchmark = 1;
@@ -68,12 +266,39 @@ int main(int argc, char* argv[])
     case 'e':
       entryname = optarg;
       break;
+    case 'g':
+      status |= VFM_PROFILING_STATUS | VFM_NGRAM_STATUS;
+      ngram = atoi(optarg);
+      break;
+    case 'H':
+      counters = 1;
+      break;
+    case 'i':
+      image = optarg;
+      break;
+    case 'I':
+      initname = optarg;
+      break;
+    case 'j':
+      threads = atoi(optarg);
+      break;
     case 'l':
       archive = optarg;
       break;
+    case 'L':
+      status |= VFM_PROFILING_STATUS;
+      lines = 1;
+      break;
+    case 'm':
+      vfm_metrics_file = optarg;
+      break;
     case 'n':
       debug = 0;
       break;
+    case 'o':
+      status |= VFM_PROFILING_STATUS;
+      lcov = optarg;
+      break;
     case 'p':
       status |= VFM_PROFILING_STATUS;
       profile = 1;
@@ -85,28 +310,53 @@ int main(int argc, char* argv[])
     case 's':
       symbols = 1;
       break;
+    case 'S':
+      save = optarg;
+      break;
     case 't':
       status |= VFM_TRACING_STATUS;
       break;
+    case 'u':
+      usage = 1;
+      break;
+    case 'w':
+      status |= VFM_PROFILING_STATUS;
+      output = optarg;
+      break;
+    case 'z':
+      vfm_lazy = 1;
+      break;
     case '?':
     default:
       opterr = 1;
     }
 
   // Check parameters
-  if ((!archive && (argc != optind + 1)) || opterr) {
-    fprintf(stderr, "usage: vfm [-cdnpt][-b times][-e entry][-l library] object\n");
+  if ((!archive && !image && (argc != optind + 1)) || opterr) {
+    fprintf(stderr, "usage: vfm [-cdHLnptuz][-b times][-e entry][-g top][-i image][-I init][-j threads][-l library][-m file][-o file][-S image][-w file] object\n");
     fprintf(stderr, "vfm virtual forth machine run-time and dynamic analysis tool\n");
     fprintf(stderr, "  -b 	measure execution, number of times\n");
     fprintf(stderr, "  -c	measure code coverage when profiling\n");
     fprintf(stderr, "  -d	load symbols with module (default)\n");
     fprintf(stderr, "  -e 	start symbol (default main)\n");
+    fprintf(stderr, "  -g 	profile operation sequences, number of top sequences\n");
+    fprintf(stderr, "  -H	hardware performance counters for run\n");
+    fprintf(stderr, "  -i	start from linked image (modules and data heap)\n");
+    fprintf(stderr, "  -I	initialize data heap with symbol before run and image (-S)\n");
+    fprintf(stderr, "  -j	run on threads; latency and throughput (scaling)\n");
     fprintf(stderr, "  -l	load object code files from library\n");
+    fprintf(stderr, "  -L	profile source lines (vfc -g)\n");
+    fprintf(stderr, "  -m	write metrics to file on SIGUSR1 and exit, SIGUSR2 toggles profiling\n");
     fprintf(stderr, "  -n	skip loading of symbols\n");
+    fprintf(stderr, "  -o	write source line coverage (lcov) to file\n");
     fprintf(stderr, "  -p	profile execution\n");
     fprintf(stderr, "  -s	dump object symbols\n");
     fprintf(stderr, "  -r	dump all object symbols\n");
+    fprintf(stderr, "  -S	write linked image before run (modules and data heap)\n");
     fprintf(stderr, "  -t	trace execution\n");
+    fprintf(stderr, "  -u	report memory usage and stack high-water marks\n");
+    fprintf(stderr, "  -w	write binary profile to file (vfprof)\n");
+    fprintf(stderr, "  -z	load used modules on first call (lazy)\n");
     return (-1);
   }
 
@@ -115,17 +365,34 @@ int main(int argc, char* argv[])
     fprintf(stderr, "error: illegal benchmark\n");
     return (-1);
   }
-  if (!debug && (profile || coverage)) {
-    fprintf(stderr, "warning: symbols needed\n");
-    debug = 1;
+  if (threads < 0) {
+    fprintf(stderr, "error: illegal number of threads\n");
+    return (-1);
+  }
+  if (ngram < 0) {
+    fprintf(stderr, "error: illegal number of operation sequences\n");
+    return (-1);
   }
 
   // Initiate run-time
   vfm_init();
   mod.segment.entry = 0;
 
-  // Check for library loading
-  if (archive) {
+  // Check for image, library or object loading
+  if (image) {
+    vfm_mod_t* mp;
+    if (archive || optind != argc) {
+      fprintf(stderr, "warning: parameters ignored\n");
+    }
+    file = fopen(image, "r");
+    if (!file || vfm_load_image(file, &mp, &mod.segment.entry, &heap, &heapsize)
+	|| heapsize > sizeof(dp0)) {
+      fprintf(stderr, "%s: error: unknown or illegal image file\n", image);
+      return (-1);
+    }
+    fclose(file);
+    mod = *mp;
+  } else if (archive) {
     if (!entryname) {
       fprintf(stderr, "error: undefined entry\n");
       return (-1);
@@ -163,6 +430,16 @@ int main(int argc, char* argv[])
     return (0);
   }
 
+  // Check for init symbol; run before image and entry
+  if (initname) {
+    vfm_symb_t* symb = vfm_name2symb(initname, &mod.dict);
+    if (!symb) {
+      fprintf(stderr, "%s: error: unknown init entry\n", initname);
+      return (-1);
+    }
+    init = symb->code;
+  }
+
   // Check for entry symbol
   if (entryname) {
     vfm_symb_t* symb = vfm_name2symb(entryname, &mod.dict);
@@ -177,8 +454,71 @@ int main(int argc, char* argv[])
     return (-1);
   }
 
+  // Run entry on threads; number of times per thread
+  if (threads) {
+    if (status || counters || usage || lcov || output || vfm_metrics_file || heapsize || init || save)
+      fprintf(stderr, "warning: options ignored\n");
+    return (run_threads(&mod, threads, times) ? -1 : 0);
+  }
+
+  // Install request handlers for live metrics
+  if (vfm_metrics_file) {
+    signal(SIGUSR1, request_handler);
+    signal(SIGUSR2, request_handler);
+  }
+
+  // Poison stacks for high-water marks
+  if (usage || vfm_metrics_file) {
+    env.sp0 = sp0;
+    env.rp0 = rp0;
+    env.dp0 = dp0;
+    env.spsize = DATA_STACK_SIZE;
+    env.rpsize = RETURN_STACK_SIZE;
+    env.dpsize = DATA_HEAP_SIZE;
+    vfm_poison(&env);
+  }
+
+  // Restore data heap from image
+  if (heapsize) memcpy(dp0, heap, heapsize);
+
+  // Run init entry; the initialized data heap is kept for the run
+  if (init) {
+    env.status = VFM_NORMAL_STATUS;
+    env.sp = env.sp0 = sp0; 
+    env.rp = env.rp0 = rp0; 
+    env.dp0 = dp0; 
+    env.dp = dp0 + heapsize / sizeof(vfm_data_t); 
+    env.spsize = DATA_STACK_SIZE;
+    env.rpsize = RETURN_STACK_SIZE;
+    env.dpsize = DATA_HEAP_SIZE;
+    env.mp = &mod; 
+    env.ip = init;
+    if (vfm_run(&env)) {
+      fprintf(stderr, "%s: error: init entry failed\n", initname);
+      return (-1);
+    }
+    heapsize = (env.dp - dp0) * sizeof(vfm_data_t);
+  }
+
+  // Write linked image; state after load and init, before the run
+  if (save) {
+    file = fopen(save, "w");
+    if (!file || vfm_save_image(file, &mod, mod.segment.entry, dp0, heapsize)) {
+      fprintf(stderr, "%s: error: could not write image file\n", save);
+      return (-1);
+    }
+    fclose(file);
+  }
+
+  // Open hardware performance counters
+  if (counters && vfm_perf_open(&perf) == 0) {
+    fprintf(stderr, "warning: hardware performance counters not available\n");
+    counters = 0;
+  }
+
   // Run entry
   errno = 0;
+  if (counters) vfm_perf_start(&perf);
   if (benchmark) {
     struct timeval start;
     struct timeval stop;
@@ -187,10 +527,15 @@ int main(int argc, char* argv[])
       env.status = status;
       env.sp = env.sp0 = sp0; 
       env.rp = env.rp0 = rp0; 
-      env.dp = env.dp0 = dp0; 
+      env.dp0 = dp0; 
+      env.dp = dp0 + heapsize / sizeof(vfm_data_t); 
+      env.spsize = DATA_STACK_SIZE;
+      env.rpsize = RETURN_STACK_SIZE;
+      env.dpsize = DATA_HEAP_SIZE;
       env.mp = &mod; 
       env.ip = mod.segment.entry;
       errno = vfm_run(&env);
+      status = env.status;
     }
     gettimeofday(&stop, NULL);
     printf("%5.f ms\n", 
@@ -200,13 +545,57 @@ int main(int argc, char* argv[])
     env.status = status;
     env.sp = env.sp0 = sp0; 
     env.rp = env.rp0 = rp0; 
-    env.dp = env.dp0 = dp0; 
+    env.dp0 = dp0; 
+    env.dp = dp0 + heapsize / sizeof(vfm_data_t); 
+    env.spsize = DATA_STACK_SIZE;
+    env.rpsize = RETURN_STACK_SIZE;
+    env.dpsize = DATA_HEAP_SIZE;
     env.mp = &mod; 
     env.ip = mod.segment.entry;
     errno = vfm_run(&env);
   }
+  if (counters) {
+    vfm_perf_stop(&perf);
+    vfm_perf_print(stdout, &perf);
+    vfm_perf_close(&perf);
+  }
+  if (errno == VFM_TRAP_ERR) {
+    fprintf(stderr, "error: operation not available (%d)\n", 
+	    (int) (env.ip - env.mp->segment.code - 1));
+  }
+  if (vfm_metrics_file && vfm_snapshot(&env)) {
+    fprintf(stderr, "%s: error: could not write metrics file\n", 
+	    vfm_metrics_file);
+    return (-1);
+  }
   if (profile) vfm_profile(stdout, &mod);
   if (coverage) vfm_coverage(stdout, &mod);
-
+  if (ngram) vfm_ngram_profile(stdout, ngram);
+  if (lines) vfm_line_profile(stdout, &mod);
+  if (usage) {
+    int i;
+    vfm_dump_memory(stdout, 1, &mod);
+    for (i = 0; i < mod.use.count; i++)
+      vfm_dump_memory(stdout, 0, mod.use.mod[i]);
+    vfm_dump_env(stdout, &env);
+  }
+  if (lcov) {
+    file = fopen(lcov, "w");
+    if (!file) {
+      fprintf(stderr, "%s: error: could not create coverage file\n", lcov);
+      return (-1);
+    }
+    vfm_lcov(file, &mod);
+    fclose(file);
+  }
+  if (output) {
+    file = fopen(output, "w");
+    if (!file) {
+      fprintf(stderr, "%s: error: could not create profile file\n", output);
+      return (-1);
+    }
+    vfm_profile_store(file, &mod);
+    fclose(file);
+  }
   return (errno);
 }
@@ -0,0 +1,297 @@
+/* Copyright 2009, Mikael Patel
+   This file is part of vfm, virtual forth machine project.
+ 
+   vfm is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+ 
+   vfm is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+ 
+   You should have received a copy of the GNU General Public License
+   along with vfm.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include "vfm.h"
+#include <unistd.h>
+#include <string.h>
+#include <stdlib.h>
+
+// NB: Profile entries are hashed on module, timestamp, name and offset.
+// NB: Entries from modules with different timestamps are kept apart.
+
+#define STRING_MAX 256
+#define HASH_MAX 4096
+
+typedef struct entry_t {
+  struct entry_t* next;
+  char* module;
+  char* name;
+  int timestamp;
+  int offset;
+  long long refcnt[2];
+} entry_t;
+
+static entry_t* hashtab[HASH_MAX];
+static entry_t** entries = 0;
+static int count = 0;
+static int size = 0;
+
+static unsigned hash(char* module, char* name, int timestamp, int offset)
+{
+  unsigned h = timestamp ^ (offset * 31);
+  while (*module) h = h * 31 + *module++;
+  while (*name) h = h * 31 + *name++;
+  return (h % HASH_MAX);
+}
+
+static entry_t* lookup(char* module, char* name, int timestamp, int offset)
+{
+  unsigned h = hash(module, name, timestamp, offset);
+  entry_t* ep;
+
+  // Search hash chain
+  for (ep = hashtab[h]; ep; ep = ep->next)
+    if (ep->timestamp == timestamp && ep->offset == offset
+	&& !strcmp(ep->module, module) && !strcmp(ep->name, name))
+      return (ep);
+
+  // Not found; create entry and append to entry list
+  if (count == size) {
+    size = (size ? 2 * size : 1024);
+    entries = (entry_t**) realloc(entries, sizeof(entry_t*) * size);
+    if (!entries) return (0);
+  }
+  ep = (entry_t*) malloc(sizeof(entry_t));
+  if (!ep) return (0);
+  ep->module = strdup(module);
+  ep->name = strdup(name);
+  ep->timestamp = timestamp;
+  ep->offset = offset;
+  ep->refcnt[0] = 0;
+  ep->refcnt[1] = 0;
+  ep->next = hashtab[h];
+  hashtab[h] = ep;
+  entries[count++] = ep;
+  return (ep);
+}
+
+static int load(char* filename, int set, time_t* first, time_t* last)
+{
+  char magic[64];
+  char module[STRING_MAX];
+  char name[STRING_MAX];
+  entry_t* ep;
+  FILE* file;
+  int timestamp;
+  int modules;
+  int records;
+  long long refcnt;
+  int offset;
+  int i;
+  int j;
+
+  // Open profile file and check magic string
+  file = fopen(filename, "r");
+  if (!file) {
+    fprintf(stderr, "%s: error: unknown profile file\n", filename);
+    return (-1);
+  }
+  if (!fgets(magic, sizeof(magic), file) || strcmp(magic, VFM_PROF_MAGIC)) {
+    fprintf(stderr, "%s: error: illegal profile file\n", filename);
+    fclose(file);
+    return (-1);
+  }
+
+  // Read profile time and update time range
+  fgetint(&timestamp, file);
+  if (*first == 0 || timestamp < *first) *first = timestamp;
+  if (timestamp > *last) *last = timestamp;
+
+  // Read module records and add counters
+  fgetint(&modules, file);
+  for (i = 0; i < modules; i++) {
+    fgetstr(module, file);
+    fgetint(&timestamp, file);
+    fgetint(&records, file);
+    for (j = 0; j < records; j++) {
+      fgetstr(name, file);
+      fgetint(&offset, file);
+      if (fgetlong(&refcnt, file) != 1) {
+	fprintf(stderr, "%s: error: truncated profile file\n", filename);
+	fclose(file);
+	return (-1);
+      }
+      ep = lookup(module, name, timestamp, offset);
+      if (!ep) return (-1);
+      ep->refcnt[set] += refcnt;
+    }
+  }
+  fclose(file);
+  return (0);
+}
+
+static int cmp_module(const void* x, const void* y)
+{
+  entry_t* a = *(entry_t**) x;
+  entry_t* b = *(entry_t**) y;
+  int res = strcmp(a->module, b->module);
+  if (res) return (res);
+  if (a->timestamp != b->timestamp) return (a->timestamp - b->timestamp);
+  return (a->offset - b->offset);
+}
+
+static long long delta(entry_t* ep)
+{
+  long long d = ep->refcnt[1] - ep->refcnt[0];
+  return (d < 0 ? -d : d);
+}
+
+static int cmp_refcnt(const void* x, const void* y)
+{
+  entry_t* a = *(entry_t**) x;
+  entry_t* b = *(entry_t**) y;
+  if (a->refcnt[0] == b->refcnt[0]) return (0);
+  return (a->refcnt[0] < b->refcnt[0] ? 1 : -1);
+}
+
+static int cmp_delta(const void* x, const void* y)
+{
+  long long a = delta(*(entry_t**) x);
+  long long b = delta(*(entry_t**) y);
+  if (a == b) return (0);
+  return (a < b ? 1 : -1);
+}
+
+static int store(char* filename)
+{
+  FILE* file;
+  int modules;
+  int records;
+  int i;
+  int j;
+
+  file = fopen(filename, "w");
+  if (!file) {
+    fprintf(stderr, "%s: error: could not create profile file\n", filename);
+    return (-1);
+  }
+
+  // Group entries by module and timestamp, and count modules
+  qsort(entries, count, sizeof(entry_t*), cmp_module);
+  for (modules = 0, i = 0; i < count; i++)
+    if (i == 0 || strcmp(entries[i - 1]->module, entries[i]->module)
+	|| entries[i - 1]->timestamp != entries[i]->timestamp)
+      modules += 1;
+
+  // Write header and module records
+  fputs(VFM_PROF_MAGIC, file);
+  fputint((int) time(NULL), file);
+  fputint(modules, file);
+  for (i = 0; i < count; i = j) {
+    for (j = i; j < count
+	   && !strcmp(entries[i]->module, entries[j]->module)
+	   && entries[i]->timestamp == entries[j]->timestamp; j++);
+    records = j - i;
+    fputstr(entries[i]->module, file);
+    fputint(entries[i]->timestamp, file);
+    fputint(records, file);
+    for (; i < j; i++) {
+      fputstr(entries[i]->name, file);
+      fputint(entries[i]->offset, file);
+      fputlong(entries[i]->refcnt[0], file);
+    }
+  }
+  fclose(file);
+  return (0);
+}
+
+static void report(int top, int diff)
+{
+  long long total[2] = { 0, 0 };
+  entry_t* ep;
+  int n;
+  int i;
+
+  // Total number of kernel operation dispatches for share
+  for (i = 0; i < count; i++)
+    if (!strcmp(entries[i]->module, "vfm")) {
+      total[0] += entries[i]->refcnt[0];
+      total[1] += entries[i]->refcnt[1];
+    }
+  if (total[0] == 0) total[0] = 1;
+  if (total[1] == 0) total[1] = 1;
+
+  // Write top symbols and kernel operations; instruction entries skipped
+  qsort(entries, count, sizeof(entry_t*), diff ? cmp_delta : cmp_refcnt);
+  for (n = 0, i = 0; i < count && n < top; i++) {
+    ep = entries[i];
+    if (!*ep->name) continue;
+    if (diff) {
+      fprintf(stdout, "%12lld %12lld %+12lld %s::%s\n",
+	      ep->refcnt[0], ep->refcnt[1], ep->refcnt[1] - ep->refcnt[0],
+	      ep->module, ep->name);
+    } else {
+      fprintf(stdout, "%12lld %5.1f%% %s::%s\n",
+	      ep->refcnt[0],
+	      ep->refcnt[0] * 100.0 / total[0],
+	      ep->module, ep->name);
+    }
+    n += 1;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  char* output = 0;
+  time_t first = 0;
+  time_t last = 0;
+  int diff = 0;
+  int top = 20;
+  int opterr = 0;
+  int c;
+  int i;
+
+  // Check options
+  while ((c = getopt(argc, argv, "dn:o:")) != EOF)
+    switch (c) {
+    case 'd':
+      diff = 1;
+      break;
+    case 'n':
+      top = atoi(optarg);
+      break;
+    case 'o':
+      output = optarg;
+      break;
+    case '?':
+    default:
+      opterr = 1;
+    }
+
+  // Check parameters
+  if (optind == argc || opterr || top <= 0 || (diff && argc - optind != 2)) {
+    fprintf(stderr, "usage: vfprof [-d][-n top][-o file] profile...\n");
+    fprintf(stderr, "vfm binary profile merge and report tool\n");
+    fprintf(stderr, "  -d	difference between two profiles\n");
+    fprintf(stderr, "  -n	number of entries in report (default 20)\n");
+    fprintf(stderr, "  -o	write merged profile to file\n");
+    return (-1);
+  }
+
+  // Load and merge profiles; second profile is kept apart for difference
+  for (i = optind; i < argc; i++)
+    if (load(argv[i], diff && i > optind, &first, &last))
+      return (-1);
+
+  // Write merged profile or report
+  if (output) return (store(output));
+  if (!diff) {
+    fprintf(stdout, "%d profiles %.19s", argc - optind, ctime(&first));
+    fprintf(stdout, " .. %.19s\n", ctime(&last));
+  }
+  report(top, diff);
+  return (0);
+}
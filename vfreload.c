@@ -0,0 +1,151 @@
+/* Copyright 2009, Mikael Patel
+   This file is part of vfm, virtual forth machine project.
+
+   vfm is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   vfm is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with vfm.  If not, see <http://www.gnu.org/licenses/>. */
+
+#include "vfm.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#define RETURN_STACK_SIZE 128
+#define DATA_STACK_SIZE 256
+#define DATA_HEAP_SIZE 1024
+
+// NB: Hot reload test (make test9). The entry (main) of the object is
+// NB: run on a thread; it calls into the used module, sets the first
+// NB: heap cell and waits for the second. The used module is reloaded
+// NB: from file while the frame runs in the old code, and the old
+// NB: version must be kept by reclaim. The frame then finishes on the
+// NB: old code and a new run calls the new code (relinked call when the
+// NB: body has moved). The old version is then reclaimed (freed). The
+// NB: results (top of stack) of the two runs are printed.
+
+typedef struct run_t {
+  vfm_env_t env;
+  vfm_mod_t* mod;
+  vfm_code_t* rp0[RETURN_STACK_SIZE];
+  vfm_data_t sp0[DATA_STACK_SIZE];
+  volatile vfm_data_t dp0[DATA_HEAP_SIZE];
+  int err;
+} run_t;
+
+static vfm_code_t halt[] = { VFM_OP_HALT };
+
+static void* run(void* arg)
+{
+  run_t* rp = (run_t*) arg;
+
+  rp->env.status = VFM_NORMAL_STATUS;
+  rp->env.sp = rp->env.sp0 = rp->sp0;
+  rp->env.rp = rp->env.rp0 = rp->rp0;
+  rp->env.dp = rp->env.dp0 = (vfm_data_t*) rp->dp0;
+  rp->env.spsize = DATA_STACK_SIZE;
+  rp->env.rpsize = RETURN_STACK_SIZE;
+  rp->env.dpsize = DATA_HEAP_SIZE;
+  rp->env.mp = rp->mod;
+  rp->env.ip = rp->mod->segment.entry;
+  rp->rp0[0] = halt;
+  rp->err = vfm_run(&rp->env);
+  return (0);
+}
+
+static vfm_data_t result(run_t* rp)
+{
+  return (rp->env.sp != rp->env.sp0 ? *rp->env.sp : 0);
+}
+
+int main(int argc, char* argv[])
+{
+  vfm_env_t* env[1];
+  vfm_symb_t* symb;
+  vfm_mod_t* old = 0;
+  vfm_mod_t mod;
+  pthread_t id;
+  FILE* file;
+  run_t* rp;
+  int kept;
+  int i;
+
+  // Check parameters
+  if (argc != 4) {
+    fprintf(stderr, "usage: vfreload object module file\n");
+    fprintf(stderr, "vfm hot reload test; reload used module while running main\n");
+    return (-1);
+  }
+
+  // Load object and lookup entry and used module
+  vfm_init();
+  file = vfm_fopen_obj_file(argv[1]);
+  if (!file || vfm_load(file, 1, &mod)) {
+    fprintf(stderr, "%s: error: unknown or illegal object file\n", argv[1]);
+    return (-1);
+  }
+  fclose(file);
+  symb = vfm_name2symb("main", &mod.dict);
+  for (i = 0; i < mod.use.count; i++)
+    if (!strcmp(mod.use.mod[i]->name, argv[2])) old = mod.use.mod[i];
+  if (!symb || !old) {
+    fprintf(stderr, "%s: error: unknown entry or used module\n", argv[1]);
+    return (-1);
+  }
+  mod.segment.entry = symb->code;
+  rp = (run_t*) calloc(1, sizeof(run_t));
+  if (!rp) return (-1);
+  rp->mod = &mod;
+  env[0] = &rp->env;
+
+  // Run main on a thread and wait until running in the used module
+  if (pthread_create(&id, NULL, run, rp)) {
+    fprintf(stderr, "error: could not create thread\n");
+    return (-1);
+  }
+  while (!rp->dp0[0]) usleep(1000);
+
+  // Reload while the frame runs in the old code; the old is kept
+  file = fopen(argv[3], "r");
+  if (!file || vfm_reload(old, file)) {
+    fprintf(stderr, "%s: error: reload failed (%d)\n", argv[3], vfm_errno);
+    rp->dp0[1] = 1;
+    pthread_join(id, NULL);
+    return (-1);
+  }
+  fclose(file);
+  vfm_reclaim(env, 1);
+  kept = (old->segment.code != 0);
+
+  // Let the frame finish on the old code
+  rp->dp0[1] = 1;
+  pthread_join(id, NULL);
+  if (rp->err) {
+    fprintf(stderr, "error: run failed (%d)\n", rp->err);
+    return (-1);
+  }
+  printf("old frame: %ld\n", (long) result(rp));
+  printf("old version kept while running: %s\n", kept ? "yes" : "no");
+
+  // Call the new code; the old version is reclaimed
+  memset((void*) rp->dp0, 0, sizeof(rp->dp0));
+  rp->dp0[1] = 1;
+  run(rp);
+  if (rp->err) {
+    fprintf(stderr, "error: run failed (%d)\n", rp->err);
+    return (-1);
+  }
+  printf("new call: %ld\n", (long) result(rp));
+  vfm_reclaim(env, 1);
+
+  return (kept ? 0 : -1);
+}
@@ -0,0 +1,322 @@
+/* Copyright 2009, Mikael Patel
+   This file is part of vfm, virtual forth machine project.
+ 
+   vfm is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+ 
+   vfm is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+ 
+   You should have received a copy of the GNU General Public License
+   along with vfm.  If not, see <http://www.gnu.org/licenses/>. */
+
+
+#include "vfm.h"
+#include <unistd.h>
+#include <libgen.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/wait.h>
+
+// NB: Compiler, archiver and loader scaling benchmark for a generated
+// NB: module graph (graph.awk). The compiler (vfc) and archiver (vfa)
+// NB: are run as commands from the directory of vfscale. Cold loads
+// NB: are measured in a child process each as the loader caches used
+// NB: modules. Lookups are of all symbols of each module and of its
+// NB: used modules (qualified, module::symbol). Reload is unload and
+// NB: warm load of the graph in process. Swap is hot reload of a used
+// NB: module (vfm_reload) and reclaim of the old version. A failed step
+// NB: is "-".
+
+#define ROOT_NAME "g0_0"
+#define ARCHIVE_NAME "graph"
+#define STRING_MAX 256
+
+static char** names = 0;
+static int count = 0;
+static char* bindir;
+
+static double now()
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (ts.tv_sec * 1e9 + ts.tv_nsec);
+}
+
+static int order(char* filename)
+{
+  char name[STRING_MAX];
+  FILE* file;
+  int size = 0;
+
+  file = fopen(filename, "r");
+  if (!file) return (-1);
+  while (fscanf(file, "%255s", name) == 1) {
+    if (count == size) {
+      size = (size ? 2 * size : 256);
+      names = (char**) realloc(names, sizeof(char*) * size);
+      if (!names) return (-1);
+    }
+    names[count++] = strdup(name);
+  }
+  fclose(file);
+  return (count ? 0 : -1);
+}
+
+static double command(char* tool, char* prefix, char* suffix)
+{
+  double start;
+  char* cmd;
+  int size;
+  int res;
+  int i;
+
+  // Build command line with all module names in compile order
+  size = strlen(bindir) + strlen(tool) + strlen(prefix) + 16;
+  for (i = 0; i < count; i++) size += strlen(names[i]) + strlen(suffix) + 1;
+  cmd = (char*) malloc(size);
+  if (!cmd) return (-1.0);
+  sprintf(cmd, "%s/%s %s", bindir, tool, prefix);
+  for (i = 0; i < count; i++) {
+    strcat(cmd, " ");
+    strcat(cmd, names[i]);
+    strcat(cmd, suffix);
+  }
+  start = now();
+  res = system(cmd);
+  free(cmd);
+  return (res ? -1.0 : now() - start);
+}
+
+static int load(vfm_mod_t* mod, int archive)
+{
+  vfm_arc_t arc;
+  char name[] = ROOT_NAME;
+  FILE* file;
+  int res;
+
+  if (archive) {
+    file = vfm_fopen_arc_file(ARCHIVE_NAME);
+    if (!file || vfm_arc_map_load(file, &arc)) return (-1);
+    res = vfm_arc_load(file, name, 1, mod, &arc);
+  } else {
+    file = vfm_fopen_obj_file(name);
+    if (!file) return (-1);
+    res = vfm_load(file, 1, mod);
+  }
+  fclose(file);
+  return (res);
+}
+
+static double cold_load(int archive)
+{
+  vfm_mod_t mod;
+  double ns = -1.0;
+  double start;
+  int fd[2];
+  int status;
+
+  // Measure in a child process; result through pipe
+  if (pipe(fd)) return (-1.0);
+  if (fork() == 0) {
+    close(fd[0]);
+    start = now();
+    if (!load(&mod, archive)) ns = now() - start;
+    if (write(fd[1], &ns, sizeof(ns)) != sizeof(ns)) exit(-1);
+    exit(0);
+  }
+  close(fd[1]);
+  if (read(fd[0], &ns, sizeof(ns)) != sizeof(ns)) ns = -1.0;
+  close(fd[0]);
+  wait(&status);
+  return (ns);
+}
+
+static int collect(vfm_mod_t* mod, vfm_mod_t*** mods, int* nr, int* size)
+{
+  int i;
+
+  for (i = 0; i < *nr; i++)
+    if ((*mods)[i] == mod) return (0);
+  if (*nr == *size) {
+    *size = (*size ? 2 * *size : 256);
+    *mods = (vfm_mod_t**) realloc(*mods, sizeof(vfm_mod_t*) * *size);
+    if (!*mods) return (-1);
+  }
+  (*mods)[(*nr)++] = mod;
+  for (i = 0; i < mod->use.count; i++)
+    if (collect(mod->use.mod[i], mods, nr, size)) return (-1);
+  return (0);
+}
+
+static double lookup(vfm_mod_t* root, int rounds, int* symbols)
+{
+  vfm_mod_t** mods = 0;
+  vfm_mod_t* mod;
+  vfm_mod_t* use;
+  vfm_symb_t* symb;
+  char name[STRING_MAX * 2];
+  long long lookups = 0;
+  double start;
+  double ns;
+  int nr = 0;
+  int size = 0;
+  int r;
+  int i;
+  int j;
+  int k;
+
+  // Collect all loaded modules once
+  if (collect(root, &mods, &nr, &size)) return (-1.0);
+  for (*symbols = 0, i = 0; i < nr; i++) *symbols += mods[i]->dict.count;
+
+  // Local and qualified lookups; the name is copied as it is parsed
+  start = now();
+  for (r = 0; r < rounds; r++) {
+    for (i = 0; i < nr; i++) {
+      mod = mods[i];
+      for (k = 0; k < mod->dict.count; k++, lookups++) {
+	strcpy(name, mod->dict.symbols[k].name);
+	if (vfm_lookup_module(name, &symb, mod) < 0 || !symb) return (-1.0);
+      }
+      for (j = 0; j < mod->use.count; j++) {
+	use = mod->use.mod[j];
+	for (k = 0; k < use->dict.count; k++, lookups++) {
+	  sprintf(name, "%s::%s", use->name, use->dict.symbols[k].name);
+	  if (vfm_lookup_module(name, &symb, mod) < 0 || !symb) return (-1.0);
+	}
+      }
+    }
+  }
+  ns = now() - start;
+  free(mods);
+  return (lookups ? ns / lookups : -1.0);
+}
+
+static double reload(vfm_mod_t* mod, int rounds)
+{
+  double start;
+  int r;
+
+  // Unload releases all used modules; load again from the registry
+  start = now();
+  for (r = 0; r < rounds; r++)
+    if (vfm_unload(mod) || load(mod, 0)) return (-1.0);
+  return ((now() - start) / rounds);
+}
+
+static double swap(vfm_mod_t* mod, int rounds)
+{
+  double start;
+  FILE* file;
+  int res;
+  int r;
+
+  // Reload first used module; the use list slot is switched each round
+  if (mod->use.count == 0) return (-1.0);
+  start = now();
+  for (r = 0; r < rounds; r++) {
+    file = vfm_fopen_obj_file(mod->use.mod[0]->name);
+    if (!file) return (-1.0);
+    res = vfm_reload(mod->use.mod[0], file);
+    fclose(file);
+    if (res || vfm_reclaim(0, 0)) return (-1.0);
+  }
+  return ((now() - start) / rounds);
+}
+
+static void report(char* format, double value)
+{
+  if (value < 0)
+    printf(" %10s", "-");
+  else
+    printf(format, value);
+}
+
+int main(int argc, char* argv[])
+{
+  char filename[FILENAME_MAX];
+  vfm_mod_t mod;
+  double compile = -1.0;
+  double archive = -1.0;
+  double objload = -1.0;
+  double arcload = -1.0;
+  double ns = -1.0;
+  double reloads = -1.0;
+  double swaps = -1.0;
+  int symbols = 0;
+  int header = 0;
+  int rounds = 10;
+  int opterr = 0;
+  int c;
+
+  // Check options
+  while ((c = getopt(argc, argv, "Hr:")) != EOF)
+    switch (c) {
+    case 'H':
+      header = 1;
+      break;
+    case 'r':
+      rounds = atoi(optarg);
+      break;
+    case '?':
+    default:
+      opterr = 1;
+    }
+
+  // Check parameters
+  if ((argc != optind + 1) || opterr || rounds <= 0) {
+    fprintf(stderr, "usage: vfscale [-H][-r rounds] directory\n");
+    fprintf(stderr, "vfm compiler, archiver and loader scaling benchmark (graph.awk)\n");
+    fprintf(stderr, "  -H	print header line\n");
+    fprintf(stderr, "  -r	number of symbol lookup, reload and swap rounds (default 10)\n");
+    return (-1);
+  }
+
+  // Locate tools and read compile order in graph directory
+  bindir = realpath(dirname(strdup(argv[0])), NULL);
+  if (!bindir || chdir(argv[optind])) {
+    fprintf(stderr, "%s: error: unknown directory\n", argv[optind]);
+    return (-1);
+  }
+  if (order("order")) {
+    fprintf(stderr, "%s: error: illegal or empty compile order\n", argv[optind]);
+    return (-1);
+  }
+
+  // Compile, archive, cold load, lookup and reload; stop at first failure
+  vfm_init();
+  compile = command("vfc", "-o", "");
+  if (compile >= 0) {
+    sprintf(filename, "lib%s", ARCHIVE_NAME);
+    archive = command("vfa", filename, ".vfm");
+    objload = cold_load(0);
+    if (archive >= 0) arcload = cold_load(1);
+    if (objload >= 0 && !load(&mod, 0)) ns = lookup(&mod, rounds, &symbols);
+    if (ns >= 0) reloads = reload(&mod, rounds);
+    if (reloads >= 0) swaps = swap(&mod, rounds);
+  }
+
+  // Write result line; times in milli-seconds and lookup in nano-seconds
+  if (header)
+    printf("%7s %7s %10s %10s %10s %10s %10s %10s %10s\n", "modules", 
+	   "symbols", "compile_ms", "archive_ms", "load_ms", "arcload_ms", 
+	   "lookup_ns", "reload_ms", "swap_ms");
+  printf("%7d %7d", count, symbols);
+  report(" %10.2f", compile / 1e6);
+  report(" %10.2f", archive / 1e6);
+  report(" %10.2f", objload / 1e6);
+  report(" %10.2f", arcload / 1e6);
+  report(" %10.1f", ns);
+  report(" %10.2f", reloads / 1e6);
+  report(" %10.2f", swaps / 1e6);
+  printf("\n");
+
+  return (swaps < 0);
+}
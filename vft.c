@@ -116,6 +116,9 @@ int main(int argc, char* argv[])
       env.sp = env.sp0 = sp0; 
       env.rp = env.rp0 = rp0; 
       env.dp = env.dp0 = dp0; 
+      env.spsize = DATA_STACK_SIZE;
+      env.rpsize = RETURN_STACK_SIZE;
+      env.dpsize = DATA_HEAP_SIZE;
       env.mp = &mod; 
       env.ip = mod.segment.entry;
       errno = vfm_run(&env);
@@ -129,6 +132,9 @@ int main(int argc, char* argv[])
     env.sp = env.sp0 = sp0; 
     env.rp = env.rp0 = rp0; 
     env.dp = env.dp0 = dp0; 
+    env.spsize = DATA_STACK_SIZE;
+    env.rpsize = RETURN_STACK_SIZE;
+    env.dpsize = DATA_HEAP_SIZE;
     env.mp = &mod; 
     env.ip = mod.segment.entry;
     errno = vfm_run(&env);